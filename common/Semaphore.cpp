@@ -9,8 +9,123 @@
 #include "common/RedtapeWindows.h"
 #endif
 
+#include <algorithm>
+#include <bit>
 #include <limits>
 
+// --------------------------------------------------------------------------------------
+//  SpinPolicy
+// --------------------------------------------------------------------------------------
+
+namespace
+{
+	/// Roughly how much later a thread runs when it sleeps instead of spinning, i.e. the cost of a futex wake.
+	static constexpr u32 WAKE_COST_NS = 10 * 1000;
+	/// Number of waits between spin time updates. The old waits are halved in weight on each update.
+	static constexpr u32 WAITS_PER_UPDATE = 256;
+} // namespace
+
+static u64 TicksToNanoseconds(u64 ticks)
+{
+	static const double ns_per_tick = 1e9 / static_cast<double>(GetTickFrequency());
+	return static_cast<u64>(static_cast<double>(ticks) * ns_per_tick);
+}
+
+static u32 GetWaitBucket(u64 ns)
+{
+	const u64 us = ns / 1000;
+	return std::min<u32>(static_cast<u32>(std::bit_width(us)), Threading::SpinPolicy::NUM_BUCKETS - 1);
+}
+
+static u32 GetInitialSpinTime(Threading::SpinPolicy::Mode mode)
+{
+	// Adaptive starts out not spinning, and only spins once it sees short waits.
+	return (mode == Threading::SpinPolicy::Mode::Spin) ? SPIN_TIME_NS : 0;
+}
+
+void Threading::SpinPolicy::SetMode(Mode mode)
+{
+	m_mode.store(mode, std::memory_order_relaxed);
+	m_spin_time.store(GetInitialSpinTime(mode), std::memory_order_relaxed);
+	m_reset_requested.store(true, std::memory_order_release);
+}
+
+void Threading::SpinPolicy::RecordWait(u64 ns, bool slept)
+{
+	if (m_reset_requested.load(std::memory_order_relaxed) && m_reset_requested.exchange(false, std::memory_order_acquire))
+	{
+		// The waiting thread may have been updating the spin time while the mode changed, so set it again.
+		m_weights.fill(0.0f);
+		m_waits_since_update = 0;
+		m_spin_time.store(GetInitialSpinTime(GetMode()), std::memory_order_relaxed);
+	}
+
+	m_counts[GetWaitBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+	m_wait_time.fetch_add(ns, std::memory_order_relaxed);
+
+	// If we slept, the work showed up around a wake up ago. Don't count that as part of the wait,
+	// otherwise sleeping makes waits look longer, and we'd never go back to spinning.
+	u64 arrival = ns;
+	if (slept)
+		arrival = std::max<u64>(GetSpinTime(), (ns > WAKE_COST_NS) ? (ns - WAKE_COST_NS) : 0);
+	m_weights[GetWaitBucket(arrival)] += 1.0f;
+
+	if (++m_waits_since_update >= WAITS_PER_UPDATE)
+		UpdateSpinTime();
+}
+
+void Threading::SpinPolicy::UpdateSpinTime()
+{
+	m_waits_since_update = 0;
+
+	if (GetMode() == Mode::Adaptive)
+	{
+		// Spinning for 2^k us catches the waits in buckets 0..k, at the cost of the time spent spinning for them.
+		// Everything longer burns the whole spin, then pays for the wake up on top. Pick the cheapest.
+		float spin_cost = 0.0f;
+		float best_cost = 0.0f;
+		for (float weight : m_weights)
+			best_cost += weight * static_cast<float>(WAKE_COST_NS);
+
+		u32 best_spin = 0;
+		for (u32 k = 0; k < NUM_BUCKETS && (1000u << k) <= SPIN_TIME_NS; k++)
+		{
+			const u32 spin_ns = 1000u << k;
+			const float typical_wait_ns = (k == 0) ? 500.0f : (750.0f * static_cast<float>(1u << k));
+			spin_cost += m_weights[k] * typical_wait_ns;
+
+			float cost = spin_cost;
+			for (u32 b = k + 1; b < NUM_BUCKETS; b++)
+				cost += m_weights[b] * static_cast<float>(spin_ns + WAKE_COST_NS);
+
+			if (cost < best_cost)
+			{
+				best_cost = cost;
+				best_spin = spin_ns;
+			}
+		}
+
+		m_spin_time.store(best_spin, std::memory_order_relaxed);
+	}
+
+	for (float& weight : m_weights)
+		weight *= 0.5f;
+}
+
+void Threading::SpinPolicy::CollectHistogram(Histogram& histogram)
+{
+	for (u32 i = 0; i < NUM_BUCKETS; i++)
+		histogram[i] += m_counts[i].exchange(0, std::memory_order_relaxed);
+}
+
+void Threading::SpinPolicy::Reset()
+{
+	SetMode(GetMode());
+	for (std::atomic<u32>& count : m_counts)
+		count.store(0, std::memory_order_relaxed);
+	m_wait_time.store(0, std::memory_order_relaxed);
+}
+
 // --------------------------------------------------------------------------------------
 //  Semaphore Implementations
 // --------------------------------------------------------------------------------------
@@ -61,6 +176,25 @@ void Threading::WorkSema::WaitForWork()
 }
 
 void Threading::WorkSema::WaitForWorkWithSpin()
+{
+	SpinThenWaitForWork(SPIN_TIME_NS);
+}
+
+void Threading::WorkSema::WaitForWork(SpinPolicy& policy)
+{
+	// Don't count calls where there's already work queued as waits.
+	if (!IsReadyForSleep(m_state.load(std::memory_order_relaxed)))
+	{
+		WaitForWork();
+		return;
+	}
+
+	const u64 start = GetCPUTicks();
+	const bool slept = SpinThenWaitForWork(policy.GetSpinTime());
+	policy.RecordWait(TicksToNanoseconds(GetCPUTicks() - start), slept);
+}
+
+bool Threading::WorkSema::SpinThenWaitForWork(u32 spin_ns)
 {
 	s32 value = m_state.load(std::memory_order_relaxed);
 	pxAssert(!IsDead(value));
@@ -75,13 +209,15 @@ void Threading::WorkSema::WaitForWorkWithSpin()
 		}
 	}
 	u32 waited = 0;
+	bool slept = false;
 	while (value < 0)
 	{
-		if (waited > SPIN_TIME_NS)
+		if (waited >= spin_ns)
 		{
 			if (!m_state.compare_exchange_weak(value, STATE_SLEEPING, std::memory_order_relaxed))
 				continue;
 			m_sema.Wait();
+			slept = true;
 			break;
 		}
 		waited += ShortSpin();
@@ -89,6 +225,7 @@ void Threading::WorkSema::WaitForWorkWithSpin()
 	}
 	// Clear back to STATE_RUNNING_0 (but preserve waiting empty flag)
 	m_state.fetch_and(STATE_FLAG_WAITING_EMPTY, std::memory_order_acquire);
+	return slept;
 }
 
 bool Threading::WorkSema::WaitForEmpty()
@@ -108,20 +245,42 @@ bool Threading::WorkSema::WaitForEmpty()
 }
 
 bool Threading::WorkSema::WaitForEmptyWithSpin()
+{
+	bool slept;
+	return SpinThenWaitForEmpty(SPIN_TIME_NS, slept);
+}
+
+bool Threading::WorkSema::WaitForEmpty(SpinPolicy& policy)
+{
+	// Don't count calls where the queue is already empty as waits.
+	const s32 value = m_state.load(std::memory_order_acquire);
+	if (value < 0)
+		return !IsDead(value);
+
+	const u64 start = GetCPUTicks();
+	bool slept;
+	const bool alive = SpinThenWaitForEmpty(policy.GetSpinTime(), slept);
+	policy.RecordWait(TicksToNanoseconds(GetCPUTicks() - start), slept);
+	return alive;
+}
+
+bool Threading::WorkSema::SpinThenWaitForEmpty(u32 spin_ns, bool& slept)
 {
 	s32 value = m_state.load(std::memory_order_acquire);
 	u32 waited = 0;
+	slept = false;
 	while (true)
 	{
 		if (value < 0)
 			return !IsDead(value); // STATE_SLEEPING or STATE_SPINNING, queue is empty!
-		if (waited > SPIN_TIME_NS && m_state.compare_exchange_weak(value, value | STATE_FLAG_WAITING_EMPTY, std::memory_order_acquire))
+		if (waited >= spin_ns && m_state.compare_exchange_weak(value, value | STATE_FLAG_WAITING_EMPTY, std::memory_order_acquire))
 			break;
 		waited += ShortSpin();
 		value = m_state.load(std::memory_order_acquire);
 	}
 	pxAssertMsg(!(value & STATE_FLAG_WAITING_EMPTY), "Multiple threads attempted to wait for empty (not currently supported)");
 	m_empty_sema.Wait();
+	slept = true;
 	return !IsDead(m_state.load(std::memory_order_relaxed));
 }
 
@@ -11,6 +11,7 @@
 #include <semaphore.h>
 #endif
 
+#include <array>
 #include <atomic>
 #include <functional>
 
@@ -143,6 +144,59 @@ namespace Threading
 		bool TryWait();
 	};
 
+	/// Decides how long a thread should spin before sleeping when it waits on another thread.
+	///
+	/// Recent waits are kept in a histogram of power-of-two microsecond buckets. In adaptive mode, the spin
+	/// time is periodically set to whichever candidate minimizes the cost of those waits, where spinning costs
+	/// the time spent spinning and sleeping costs a kernel wake up. So threads which usually hand off to each
+	/// other quickly spin, and threads which usually wait for a long time go straight to sleep.
+	class SpinPolicy
+	{
+	public:
+		enum class Mode : u8
+		{
+			Adaptive,
+			Sleep, ///< Never spin.
+			Spin, ///< Always spin for the maximum time (SPIN_TIME_NS) before sleeping.
+		};
+
+		/// Bucket N counts waits shorter than 2^N microseconds, the last bucket also counts anything longer.
+		static constexpr u32 NUM_BUCKETS = 16;
+		using Histogram = std::array<u32, NUM_BUCKETS>;
+
+		Mode GetMode() const { return m_mode.load(std::memory_order_relaxed); }
+		void SetMode(Mode mode);
+
+		/// Returns the number of nanoseconds to spin for before sleeping.
+		u32 GetSpinTime() const { return m_spin_time.load(std::memory_order_relaxed); }
+
+		/// Records a wait which took the given number of nanoseconds, and whether the thread had to sleep.
+		/// Should only be called by the waiting thread.
+		void RecordWait(u64 ns, bool slept);
+
+		/// Adds the waits recorded since the last call to the histogram. Can be called from any thread.
+		void CollectHistogram(Histogram& histogram);
+
+		/// Returns the total time in nanoseconds spent waiting since the last call. Can be called from any thread.
+		u64 CollectWaitTime() { return m_wait_time.exchange(0, std::memory_order_relaxed); }
+
+		/// Forgets the recorded waits, e.g. because a different game is starting. Can be called from any thread.
+		void Reset();
+
+	private:
+		void UpdateSpinTime();
+
+		/// Counts for CollectHistogram().
+		std::array<std::atomic<u32>, NUM_BUCKETS> m_counts = {};
+		std::atomic<u64> m_wait_time{0};
+		/// Decaying counts used to pick the spin time, only touched by the waiting thread.
+		std::array<float, NUM_BUCKETS> m_weights = {};
+		u32 m_waits_since_update = 0;
+		std::atomic<u32> m_spin_time{0};
+		std::atomic<Mode> m_mode{Mode::Adaptive};
+		std::atomic_bool m_reset_requested{false};
+	};
+
 	/// A semaphore for notifying a work-processing thread of new work in a (separate) queue
 	///
 	/// Usage:
@@ -186,6 +240,11 @@ namespace Threading
 			return new_state | (current & STATE_FLAG_WAITING_EMPTY); // Preserve waiting empty flag for RUNNING_N → RUNNING_0
 		}
 
+		/// Returns true if the thread had to sleep.
+		bool SpinThenWaitForWork(u32 spin_ns);
+		/// Sets slept if the thread had to sleep, returns false if the worker is dead.
+		bool SpinThenWaitForEmpty(u32 spin_ns, bool& slept);
+
 	public:
 		/// Notify the worker thread that you've added new work to its queue
 		void NotifyOfWork()
@@ -207,12 +266,17 @@ namespace Threading
 		void WaitForWork();
 		/// Wait for work to be added to the queue, spinning for a bit before sleeping the thread
 		void WaitForWorkWithSpin();
+		/// Wait for work to be added to the queue, spinning for as long as the policy says before sleeping the thread
+		void WaitForWork(SpinPolicy& policy);
 		/// Wait for the worker thread to finish processing all entries in the queue or die
 		/// Returns false if the thread is dead
 		bool WaitForEmpty();
 		/// Wait for the worker thread to finish processing all entries in the queue or die, spinning a bit before sleeping the thread
 		/// Returns false if the thread is dead
 		bool WaitForEmptyWithSpin();
+		/// Wait for the worker thread to finish processing all entries in the queue or die, spinning for as long as the policy says before sleeping the thread
+		/// Returns false if the thread is dead
+		bool WaitForEmpty(SpinPolicy& policy);
 		/// Called by the worker thread to notify others of its death
 		/// Dead threads don't process work, and WaitForEmpty will return instantly even though there may be work in the queue
 		void Kill();
@@ -63,6 +63,7 @@ OSDSettingsWidget::OSDSettingsWidget(SettingsWindow* settings_dialog, QWidget* p
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.showUsageGPU, "EmuCore/GS", "OsdShowGPU", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.showDebugGPU, "EmuCore/GS", "OsdShowGPUDebug", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.showStatsGPU, "EmuCore/GS", "OsdShowGPUStats", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.showStatsRings, "EmuCore/GS", "OsdShowRingStats", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.showStatusIndicators, "EmuCore/GS", "OsdShowIndicators", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.showFrameTimes, "EmuCore/GS", "OsdShowFrameTimes", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.showHardwareInfo, "EmuCore/GS", "OsdShowHardwareInfo", false);
@@ -130,6 +131,8 @@ OSDSettingsWidget::OSDSettingsWidget(SettingsWindow* settings_dialog, QWidget* p
 #endif
 	dialog()->registerWidgetHelp(m_ui.showDebugGPU, tr("Show GPU Pipeline Statistics"),
 		tr("Unchecked"), tr("Shows GPU vertex shader and pixels shader invocations."));
+	dialog()->registerWidgetHelp(m_ui.showStatsRings, tr("Show Thread Ring Statistics"), tr("Unchecked"),
+		tr("Shows how often the EE waits for space in the GS and VU thread queues, how long those threads sit idle, and how full the queues get."));
 	dialog()->registerWidgetHelp(m_ui.showFrameTimes, tr("Show Frame Times"), tr("Unchecked"),
 		tr("Displays a graph showing the average frametimes."));
 
@@ -247,6 +250,7 @@ void OSDSettingsWidget::onPerformancePosChanged()
 	m_ui.showUsageCPU->setEnabled(enabled);
 	m_ui.showUsageGPU->setEnabled(enabled);
 	m_ui.showStatsGPU->setEnabled(enabled);
+	m_ui.showStatsRings->setEnabled(enabled);
 	m_ui.showStatusIndicators->setEnabled(enabled);
 	m_ui.showFrameTimes->setEnabled(enabled);
 	m_ui.showHardwareInfo->setEnabled(enabled);
@@ -270,6 +274,7 @@ void OSDSettingsWidget::setAllCheckboxes(bool checked)
 		m_ui.showUsageCPU,
 		m_ui.showUsageGPU,
 		m_ui.showStatsGPU,
+		m_ui.showStatsRings,
 		m_ui.showFrameTimes,
 		m_ui.showHardwareInfo,
 		m_ui.showVersion,
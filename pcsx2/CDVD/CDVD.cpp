@@ -574,15 +574,12 @@ static std::string ExecutablePathToSerial(const std::string& path)
 	return serial;
 }
 
-void cdvdGetDiscInfo(std::string* out_serial, std::string* out_elf_path, std::string* out_version, u32* out_crc,
-	CDVDDiscType* out_disc_type)
+static void GetDiscInfo(IsoReader& isor, bool opened, Error& error, std::string* out_serial, std::string* out_elf_path,
+	std::string* out_version, u32* out_crc, CDVDDiscType* out_disc_type)
 {
-	Error error;
-	IsoReader isor;
-
 	std::string elfpath, version;
 	CDVDDiscType disc_type = CDVDDiscType::Other;
-	if (!isor.Open(&error) || (disc_type = GetPS2ElfName(isor, &elfpath, &version, &error)) == CDVDDiscType::Other)
+	if (!opened || (disc_type = GetPS2ElfName(isor, &elfpath, &version, &error)) == CDVDDiscType::Other)
 		Console.Error(fmt::format("Failed to get ELF name: {}", error.GetDescription()));
 
 	// Don't bother parsing it if we don't need the CRC.
@@ -618,6 +615,32 @@ void cdvdGetDiscInfo(std::string* out_serial, std::string* out_elf_path, std::st
 		*out_disc_type = disc_type;
 }
 
+void cdvdGetDiscInfo(std::string* out_serial, std::string* out_elf_path, std::string* out_version, u32* out_crc,
+	CDVDDiscType* out_disc_type)
+{
+	Error error;
+	IsoReader isor;
+	const bool opened = isor.Open(&error);
+	GetDiscInfo(isor, opened, error, out_serial, out_elf_path, out_version, out_crc, out_disc_type);
+}
+
+bool cdvdGetImageDiscInfo(const std::string& path, s32* out_disk_type, std::string* out_serial, u32* out_crc,
+	Error* error)
+{
+	InputIsoFile iso;
+	if (!iso.Open(path, error))
+		return false;
+
+	Error fs_error;
+	IsoReader isor;
+	const bool opened = isor.Open(iso, &fs_error);
+	if (out_disk_type)
+		*out_disk_type = cdvdDetectImageDiskType(iso, opened ? &isor : nullptr);
+
+	GetDiscInfo(isor, opened, fs_error, out_serial, nullptr, nullptr, out_crc, nullptr);
+	return true;
+}
+
 void cdvdReadKey(u8, u16, u32 arg2, u8* key)
 {
 	const std::string DiscSerial = VMManager::GetDiscSerial();
@@ -69,13 +69,12 @@ static void CheckNullCDVD()
 //////////////////////////////////////////////////////////////////////////////////////////
 // Disk Type detection stuff (from cdvdGigaherz)
 //
-static int CheckDiskTypeFS(int baseType)
+static int CheckDiskTypeFS(IsoReader* isor, int baseType)
 {
-	IsoReader isor;
-	if (isor.Open())
+	if (isor)
 	{
 		std::vector<u8> data;
-		if (isor.ReadFile("SYSTEM.CNF", &data))
+		if (isor->ReadFile("SYSTEM.CNF", &data))
 		{
 			if (StringUtil::ContainsSubString(data, "BOOT2"))
 			{
@@ -93,13 +92,13 @@ static int CheckDiskTypeFS(int baseType)
 		}
 
 		// PS2 Linux disc 2, doesn't have a System.CNF or a normal ELF
-		if (isor.FileExists("P2L_0100.02"))
+		if (isor->FileExists("P2L_0100.02"))
 			return CDVD_TYPE_PS2DVD;
 
-		if (isor.FileExists("PSX.EXE"))
+		if (isor->FileExists("PSX.EXE"))
 			return CDVD_TYPE_PSCD;
 
-		if (isor.FileExists("VIDEO_TS/VIDEO_TS.IFO"))
+		if (isor->FileExists("VIDEO_TS/VIDEO_TS.IFO"))
 			return CDVD_TYPE_DVDV;
 	}
 
@@ -109,6 +108,12 @@ static int CheckDiskTypeFS(int baseType)
 	return CDVD_TYPE_ILLEGAL; // << Only for discs which aren't ps2 at all.
 }
 
+static int CheckDiskTypeFS(int baseType)
+{
+	IsoReader isor;
+	return CheckDiskTypeFS(isor.Open() ? &isor : nullptr, baseType);
+}
+
 static int FindDiskType(int mType)
 {
 	int dataTracks = 0;
@@ -227,6 +232,25 @@ static int FindDiskType(int mType)
 	return iCDType;
 }
 
+s32 cdvdDetectImageDiskType(InputIsoFile& iso, IsoReader* isor)
+{
+	// Images are always a single data track, so this is the mType < 0 path of FindDiskType()
+	// without going through the global CDVD interface. Layer count doesn't affect the result.
+	int base_type = CDVD_TYPE_DETCTDVDS;
+	if (iso.GetBlockCount() <= 452849)
+	{
+		u8 raw[CD_FRAMESIZE_RAW];
+		if (iso.ReadSync(raw, 16) >= 0)
+		{
+			const u8* sector = raw + 24;
+			if (*(u16*)(sector + 166) == *(u16*)(sector + 171))
+				base_type = CDVD_TYPE_DETCTCD;
+		}
+	}
+
+	return CheckDiskTypeFS(isor, base_type);
+}
+
 static void DetectDiskType()
 {
 	if (CDVD->getTrayStatus() == CDVD_TRAY_OPEN)
@@ -9,6 +9,8 @@
 #include <string>
 
 class Error;
+class InputIsoFile;
+class IsoReader;
 class ProgressCallback;
 
 struct cdvdTrackIndex
@@ -208,3 +210,7 @@ extern s32 DoCDVDreadTrack(u32 lsn, int mode);
 extern s32 DoCDVDgetBuffer(u8* buffer);
 extern s32 DoCDVDdetectDiskType();
 extern void DoCDVDresetDiskTypeCache();
+
+// Detects the disk type of a standalone image, without using the global CDVD interface.
+// isor should be opened on the same image, or null if it has no readable filesystem.
+extern s32 cdvdDetectImageDiskType(InputIsoFile& iso, IsoReader* isor);
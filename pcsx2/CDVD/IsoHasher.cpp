@@ -2,15 +2,31 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CDVDcommon.h"
+#include "CDVD/IsoFileFormats.h"
 #include "CDVD/IsoHasher.h"
 #include "Host.h"
 
+#include "common/Console.h"
 #include "common/Error.h"
 #include "common/MD5Digest.h"
 
 #include "fmt/format.h"
 
 #include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+static std::string FormatDigest(const u8 digest[16])
+{
+	return fmt::format(
+		"{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}", digest[0],
+		digest[1], digest[2], digest[3], digest[4], digest[5], digest[6], digest[7], digest[8], digest[9], digest[10],
+		digest[11], digest[12], digest[13], digest[14], digest[15]);
+}
 
 IsoHasher::IsoHasher() = default;
 
@@ -42,6 +58,7 @@ bool IsoHasher::Open(std::string iso_path, Error* error)
 	if (!m_is_locked)
 		return false;
 
+	m_path = iso_path;
 	CDVDsys_SetFile(CDVD_SourceType::Iso, std::move(iso_path));
 	CDVDsys_ChangeSource(CDVD_SourceType::Iso);
 
@@ -111,6 +128,7 @@ void IsoHasher::Close()
 
 	cdvdUnlock();
 	m_is_locked = false;
+	m_path.clear();
 
 	if (!m_is_open)
 		return;
@@ -123,6 +141,11 @@ void IsoHasher::Close()
 
 void IsoHasher::ComputeHashes(ProgressCallback* callback)
 {
+	// Reading through independent image readers lets decompression overlap with hashing, and tracks be hashed
+	// concurrently. Only go through the CDVD backend when the image can't be reopened.
+	if (ComputeHashesPipelined(callback))
+		return;
+
 	callback->SetProgressRange(GetTrackCount());
 	callback->SetProgressValue(0);
 	callback->SetCancellable(true);
@@ -183,11 +206,230 @@ bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 
 	u8 digest[16];
 	md5.Final(digest);
-	track.hash =
-		fmt::format("{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}",
-			digest[0], digest[1], digest[2], digest[3], digest[4], digest[5], digest[6], digest[7], digest[8],
-			digest[9], digest[10], digest[11], digest[12], digest[13], digest[14], digest[15]);
+	track.hash = FormatDigest(digest);
 
 	callback->SetProgressValue(track.sectors);
 	return true;
 }
+
+bool IsoHasher::ComputeHashesPipelined(ProgressCallback* callback)
+{
+	std::vector<Track*> pending;
+	u32 total_sectors = 0;
+	for (Track& track : m_tracks)
+	{
+		if (!track.hash.empty())
+			continue;
+
+		pending.push_back(&track);
+		total_sectors += track.sectors;
+	}
+
+	if (pending.empty())
+	{
+		callback->SetProgressRange(1);
+		callback->SetProgressValue(1);
+		return true;
+	}
+
+	// Each worker runs a reader and a hash thread, so only use half the cores. Readers are opened up front so
+	// we can fall back to the CDVD backend before any work has been done.
+	const u32 max_workers = std::max(std::thread::hardware_concurrency() / 2u, 1u);
+	const u32 num_workers = std::min(static_cast<u32>(pending.size()), max_workers);
+	std::vector<std::unique_ptr<InputIsoFile>> readers;
+	readers.reserve(num_workers);
+	for (u32 i = 0; i < num_workers; i++)
+	{
+		std::unique_ptr<InputIsoFile> iso = std::make_unique<InputIsoFile>();
+		Error error;
+		if (m_path.empty() || !iso->Open(m_path, &error))
+		{
+			if (readers.empty())
+			{
+				Console.Warning(fmt::format("IsoHasher: Failed to reopen image, hashing sequentially: {}",
+					error.GetDescription()));
+				return false;
+			}
+
+			break;
+		}
+
+		readers.push_back(std::move(iso));
+	}
+
+	callback->SetCancellable(true);
+	callback->SetStatusText((pending.size() == 1) ?
+								fmt::format(TRANSLATE_FS("CDVD", "Calculating checksum for track {}..."),
+									pending.front()->number)
+									.c_str() :
+								fmt::format(TRANSLATE_FS("CDVD", "Calculating checksums for {} tracks..."),
+									pending.size())
+									.c_str());
+	callback->SetProgressRange(std::max(total_sectors, 1u));
+	callback->SetProgressValue(0);
+
+	std::atomic<u32> next_track{0};
+	std::atomic<u32> sectors_done{0};
+	std::atomic_bool cancelled{false};
+	std::mutex state_mutex;
+	std::condition_variable state_cv;
+	u32 workers_finished = 0;
+	std::string first_error;
+
+	std::vector<std::thread> workers;
+	workers.reserve(readers.size());
+	for (const std::unique_ptr<InputIsoFile>& iso : readers)
+	{
+		workers.emplace_back([this, &iso = *iso, &pending, &next_track, &sectors_done, &cancelled, &state_mutex,
+								 &state_cv, &workers_finished, &first_error]() {
+			for (;;)
+			{
+				const u32 index = next_track.fetch_add(1, std::memory_order_relaxed);
+				if (index >= pending.size() || cancelled.load(std::memory_order_relaxed))
+					break;
+
+				std::string error;
+				if (!ComputeTrackHashPipelined(iso, *pending[index], sectors_done, cancelled, &error))
+				{
+					cancelled.store(true, std::memory_order_relaxed);
+
+					std::unique_lock lock(state_mutex);
+					if (first_error.empty())
+						first_error = std::move(error);
+					break;
+				}
+			}
+
+			std::unique_lock lock(state_mutex);
+			workers_finished++;
+			state_cv.notify_one();
+		});
+	}
+
+	{
+		std::unique_lock lock(state_mutex);
+		while (workers_finished < workers.size())
+		{
+			state_cv.wait_for(lock, std::chrono::milliseconds(50));
+
+			lock.unlock();
+			if (callback->IsCancelled())
+				cancelled.store(true, std::memory_order_relaxed);
+			callback->SetProgressValue(sectors_done.load(std::memory_order_relaxed));
+			lock.lock();
+		}
+	}
+
+	for (std::thread& thread : workers)
+		thread.join();
+
+	if (!first_error.empty())
+		callback->DisplayFormattedModalError("%s", first_error.c_str());
+	else if (!cancelled.load(std::memory_order_relaxed))
+		callback->SetProgressValue(std::max(total_sectors, 1u));
+
+	return true;
+}
+
+bool IsoHasher::ComputeTrackHashPipelined(InputIsoFile& iso, Track& track, std::atomic<u32>& sectors_done,
+	const std::atomic_bool& cancelled, std::string* error) const
+{
+	// Same sector layout as the 2352/2048 byte reads in ISOreadSector().
+	const u32 sector_size = m_is_cd ? 2352 : 2048;
+	const u32 sector_offset = m_is_cd ? 0 : 24;
+
+	struct Batch
+	{
+		std::unique_ptr<u8[]> data;
+		u32 sectors;
+	};
+	std::array<Batch, PIPELINE_QUEUE_DEPTH> queue;
+	for (Batch& batch : queue)
+		batch.data = std::make_unique<u8[]>(PIPELINE_BATCH_SECTORS * sector_size);
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	u32 queued = 0;
+	bool reader_done = false;
+
+	// The hash thread consumes batches in order, while this thread keeps reading (and decompressing) ahead.
+	MD5Digest md5;
+	std::thread hash_thread([&]() {
+		u32 read_pos = 0;
+		std::unique_lock lock(mutex);
+		for (;;)
+		{
+			cv.wait(lock, [&]() { return queued > 0 || reader_done; });
+			if (queued == 0)
+				break;
+
+			const Batch& batch = queue[read_pos];
+			lock.unlock();
+
+			md5.Update(batch.data.get(), batch.sectors * sector_size);
+			sectors_done.fetch_add(batch.sectors, std::memory_order_relaxed);
+			read_pos = (read_pos + 1) % PIPELINE_QUEUE_DEPTH;
+
+			lock.lock();
+			queued--;
+			cv.notify_one();
+		}
+	});
+
+	std::unique_ptr<u8[]> raw_sector = std::make_unique<u8[]>(CD_FRAMESIZE_RAW);
+	u32 write_pos = 0;
+	bool result = true;
+	for (u32 sector = 0; sector < track.sectors && result;)
+	{
+		{
+			std::unique_lock lock(mutex);
+			cv.wait(lock, [&]() { return queued < PIPELINE_QUEUE_DEPTH; });
+		}
+
+		Batch& batch = queue[write_pos];
+		const u32 count = std::min(PIPELINE_BATCH_SECTORS, track.sectors - sector);
+		for (u32 i = 0; i < count; i++)
+		{
+			if (cancelled.load(std::memory_order_relaxed))
+			{
+				result = false;
+				break;
+			}
+
+			const u32 lsn = track.start_lsn + sector + i;
+			if (iso.ReadSync(raw_sector.get(), lsn) < 0)
+			{
+				*error = fmt::format("Read error at LSN {}", lsn);
+				result = false;
+				break;
+			}
+
+			std::memcpy(batch.data.get() + i * sector_size, raw_sector.get() + sector_offset, sector_size);
+		}
+		if (!result)
+			break;
+
+		batch.sectors = count;
+		sector += count;
+		write_pos = (write_pos + 1) % PIPELINE_QUEUE_DEPTH;
+
+		std::unique_lock lock(mutex);
+		queued++;
+		cv.notify_one();
+	}
+
+	{
+		std::unique_lock lock(mutex);
+		reader_done = true;
+		cv.notify_one();
+	}
+	hash_thread.join();
+
+	if (!result)
+		return false;
+
+	u8 digest[16];
+	md5.Final(digest);
+	track.hash = FormatDigest(digest);
+	return true;
+}
@@ -6,10 +6,12 @@
 #include "common/Pcsx2Defs.h"
 #include "common/ProgressCallback.h"
 
+#include <atomic>
 #include <string>
 #include <vector>
 
 class Error;
+class InputIsoFile;
 
 class IsoHasher
 {
@@ -44,8 +46,18 @@ public:
 	void ComputeHashes(ProgressCallback* callback = ProgressCallback::NullProgressCallback);
 
 private:
+	/// Sectors handed from a track's reader thread to its hash thread at once.
+	static constexpr u32 PIPELINE_BATCH_SECTORS = 256;
+
+	/// Batches which can be queued between the reader and hash threads of a track.
+	static constexpr u32 PIPELINE_QUEUE_DEPTH = 4;
+
+	bool ComputeHashesPipelined(ProgressCallback* callback);
+	bool ComputeTrackHashPipelined(InputIsoFile& iso, Track& track, std::atomic<u32>& sectors_done,
+		const std::atomic_bool& cancelled, std::string* error) const;
 	bool ComputeTrackHash(Track& track, ProgressCallback* callback);
 
+	std::string m_path;
 	std::vector<Track> m_tracks;
 	bool m_is_locked = false;
 	bool m_is_open = false;
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CDVDcommon.h"
+#include "CDVD/IsoFileFormats.h"
 #include "CDVD/IsoReader.h"
 
 #include "common/Assertions.h"
@@ -25,6 +26,16 @@ std::string_view IsoReader::RemoveVersionIdentifierFromPath(const std::string_vi
 
 bool IsoReader::Open(Error* error)
 {
+	m_iso = nullptr;
+	if (!ReadPVD(error))
+		return false;
+
+	return true;
+}
+
+bool IsoReader::Open(InputIsoFile& iso, Error* error)
+{
+	m_iso = &iso;
 	if (!ReadPVD(error))
 		return false;
 
@@ -33,6 +44,20 @@ bool IsoReader::Open(Error* error)
 
 bool IsoReader::ReadSector(u8* buf, u32 lsn, Error* error)
 {
+	if (m_iso)
+	{
+		// User data starts 24 bytes into the raw sector, same as CDVD_MODE_2048.
+		u8 raw[CD_FRAMESIZE_RAW];
+		if (m_iso->ReadSync(raw, lsn) < 0)
+		{
+			Error::SetString(error, fmt::format("Failed to read sector LSN #{}", lsn));
+			return false;
+		}
+
+		std::memcpy(buf, raw + 24, SECTOR_SIZE);
+		return true;
+	}
+
 	if (DoCDVDreadSector(buf, lsn, CDVD_MODE_2048) != 0)
 	{
 		Error::SetString(error, fmt::format("Failed to read sector LSN #{}", lsn));
@@ -11,6 +11,7 @@
 #include <vector>
 
 class Error;
+class InputIsoFile;
 
 class IsoReader
 {
@@ -140,10 +141,13 @@ public:
 
 	const ISOPrimaryVolumeDescriptor& GetPVD() const { return m_pvd; }
 
-	// TODO: Eventually we'll want to pass a handle to the currently-open file here.
-	// ... once I have the energy to make CDVD not depend on a global object.
+	/// Opens the filesystem on the disc currently inserted in the global CDVD interface.
 	bool Open(Error* error = nullptr);
 
+	/// Opens the filesystem on a standalone image. Does not touch any CDVD globals, so it is
+	/// safe to use from worker threads. The image must outlive the reader.
+	bool Open(InputIsoFile& iso, Error* error = nullptr);
+
 	std::vector<std::string> GetFilesInDirectory(const std::string_view path, Error* error = nullptr);
 
 	std::optional<ISODirectoryEntry> LocateFile(const std::string_view path, Error* error);
@@ -162,5 +166,6 @@ private:
 	std::optional<ISODirectoryEntry> LocateFile(const std::string_view path, u8* sector_buffer,
 		u32 directory_record_lba, u32 directory_record_size, Error* error);
 
+	InputIsoFile* m_iso = nullptr;
 	ISOPrimaryVolumeDescriptor m_pvd = {};
 };
@@ -268,6 +268,14 @@ enum class LimiterModeType : u8
 	Unlimited,
 };
 
+// Same order as Threading::SpinPolicy::Mode.
+enum class ThreadWaitModeType : u8
+{
+	Adaptive, // spin for as long as recent waits on the thread suggest is worthwhile
+	Sleep,
+	Spin,
+};
+
 enum class GSRendererType : s8
 {
 	Auto = -1,
@@ -775,6 +783,7 @@ struct Pcsx2Config
 					OsdShowGPU : 1,
 					OsdShowGPUDebug : 1,
 					OsdShowGPUStats : 1,
+					OsdShowRingStats : 1,
 					OsdShowIndicators : 1,
 					OsdShowFrameTimes : 1,
 					OsdShowHardwareInfo : 1,
@@ -998,6 +1007,7 @@ struct Pcsx2Config
 		u32 StandardVolume = 100;
 		u32 FastForwardVolume = 100;
 		bool OutputMuted = false;
+		bool MixerThread = false;
 
 		AudioBackend Backend = DEFAULT_BACKEND;
 		SPU2SyncMode SyncMode = DEFAULT_SYNC_MODE;
@@ -1135,7 +1145,8 @@ struct Pcsx2Config
 			WaitLoop : 1, // enables constant loop detection and fast-forwarding
 			vuFlagHack : 1, // microVU specific flag hack
 			vuThread : 1, // Enable Threaded VU1
-			vu1Instant : 1; // Enable Instant VU1 (Without MTVU only)
+			vu1Instant : 1, // Enable Instant VU1 (Without MTVU only)
+			ipuThread : 1; // Decode IPU macroblocks on a separate thread
 		BITFIELD_END
 
 		s8 EECycleRate; // EE cycle rate selector (1.0, 1.5, 2.0)
@@ -1397,6 +1408,9 @@ struct Pcsx2Config
 
 	int PINESlot;
 
+	// How the EE, GS and VU threads wait on each other's rings.
+	ThreadWaitModeType ThreadWaitMode = ThreadWaitModeType::Adaptive;
+
 	int RtcYear;
 	int RtcMonth;
 	int RtcDay;
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GuestProfiler.h"
+#include "SymbolGuardian.h"
+
+#include "R3000A.h"
+#include "R5900.h"
+#include "VMManager.h"
+#include "VU.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/Threading.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace GuestProfiler
+{
+	enum SampledCpu : u32
+	{
+		SAMPLED_CPU_EE,
+		SAMPLED_CPU_IOP,
+		SAMPLED_CPU_VU1,
+		SAMPLED_CPU_COUNT
+	};
+
+	static constexpr const char* s_cpu_names[SAMPLED_CPU_COUNT] = {"EE", "IOP", "VU1"};
+
+	static void SamplerThread();
+	static void SymbolizeSamples(SampledCpu cpu, std::map<std::string, u64>& folded);
+
+	static std::thread s_thread;
+	static std::atomic_bool s_active{false};
+	static std::string s_output_path;
+	static u32 s_sample_interval_us = DEFAULT_SAMPLE_INTERVAL_US;
+
+	// Only touched by the sampler thread while it's running.
+	static std::unordered_map<u32, u64> s_samples[SAMPLED_CPU_COUNT];
+} // namespace GuestProfiler
+
+bool GuestProfiler::IsActive()
+{
+	return s_active.load(std::memory_order_acquire);
+}
+
+const std::string& GuestProfiler::GetOutputPath()
+{
+	return s_output_path;
+}
+
+bool GuestProfiler::Start(std::string output_path, u32 sample_interval_us, Error* error)
+{
+	if (IsActive())
+	{
+		Error::SetStringView(error, "The profiler is already running.");
+		return false;
+	}
+
+	s_output_path = std::move(output_path);
+	s_sample_interval_us = std::max(sample_interval_us, 1u);
+	for (std::unordered_map<u32, u64>& samples : s_samples)
+		samples.clear();
+
+	s_active.store(true, std::memory_order_release);
+	s_thread = std::thread(&GuestProfiler::SamplerThread);
+
+	Console.WriteLnFmt("GuestProfiler: Sampling every {} us, writing to '{}'.", s_sample_interval_us, s_output_path);
+	return true;
+}
+
+bool GuestProfiler::Stop(Error* error)
+{
+	if (!IsActive())
+	{
+		Error::SetStringView(error, "The profiler is not running.");
+		return false;
+	}
+
+	s_active.store(false, std::memory_order_release);
+	s_thread.join();
+
+	// Aggregate by function, sorted so repeated profiles of the same game diff nicely.
+	std::map<std::string, u64> folded;
+	u64 total_samples = 0;
+	for (u32 cpu = 0; cpu < SAMPLED_CPU_COUNT; cpu++)
+	{
+		for (const auto& [pc, count] : s_samples[cpu])
+			total_samples += count;
+
+		SymbolizeSamples(static_cast<SampledCpu>(cpu), folded);
+		s_samples[cpu].clear();
+	}
+
+	std::string output;
+	for (const auto& [stack, count] : folded)
+		fmt::format_to(std::back_inserter(output), "{} {}\n", stack, count);
+
+	if (!FileSystem::WriteStringToFile(s_output_path.c_str(), output))
+	{
+		Error::SetStringFmt(error, "Failed to write profile to '{}'.", s_output_path);
+		return false;
+	}
+
+	Console.WriteLnFmt("GuestProfiler: Wrote {} samples in {} stacks to '{}'.", total_samples, folded.size(), s_output_path);
+	return true;
+}
+
+void GuestProfiler::SamplerThread()
+{
+	Threading::SetNameOfCurrentThread("Guest Profiler");
+
+	const std::chrono::microseconds interval(s_sample_interval_us);
+	auto next_sample = std::chrono::steady_clock::now();
+
+	while (s_active.load(std::memory_order_acquire))
+	{
+		next_sample += interval;
+		std::this_thread::sleep_until(next_sample);
+
+		// Don't attribute time spent paused to whatever function happened to be running.
+		if (VMManager::GetState() != VMState::Running)
+		{
+			next_sample = std::chrono::steady_clock::now();
+			continue;
+		}
+
+		// These are racy reads of the CPU state, but the registers are plain aligned words,
+		// and an occasional stale PC is fine for a statistical profile.
+		s_samples[SAMPLED_CPU_EE][cpuRegs.pc]++;
+		s_samples[SAMPLED_CPU_IOP][psxRegs.pc]++;
+
+		if (VU0.VI[REG_VPU_STAT].UL & 0x100)
+			s_samples[SAMPLED_CPU_VU1][VU1.VI[REG_TPC].UL]++;
+	}
+}
+
+void GuestProfiler::SymbolizeSamples(SampledCpu cpu, std::map<std::string, u64>& folded)
+{
+	const SymbolGuardian* guardian = nullptr;
+	if (cpu == SAMPLED_CPU_EE)
+		guardian = &R5900SymbolGuardian;
+	else if (cpu == SAMPLED_CPU_IOP)
+		guardian = &R3000SymbolGuardian;
+
+	for (const auto& [pc, count] : s_samples[cpu])
+	{
+		std::string name;
+		if (guardian)
+		{
+			name = guardian->FunctionOverlappingAddress(pc).name;
+			if (name.empty())
+				name = guardian->SymbolOverlappingAddress(pc, ccc::LABEL).name;
+		}
+
+		if (name.empty())
+		{
+			name = fmt::format("0x{:08x}", pc);
+		}
+		else
+		{
+			// ';' separates frames in the folded format.
+			std::replace(name.begin(), name.end(), ';', ':');
+		}
+
+		folded[fmt::format("{};{}", s_cpu_names[cpu], name)] += count;
+	}
+}
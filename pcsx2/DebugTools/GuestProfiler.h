@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Types.h"
+
+#include <string>
+
+class Error;
+
+// Sampling profiler for guest code. A background thread periodically captures the EE, IOP
+// and VU1 program counters while the VM is running. The recompilers only store the PC at
+// block boundaries, so samples are block-granular. When the profiler is stopped, the PCs
+// are mapped to functions using the symbol database and written out as folded stacks
+// ("EE;function count" lines), which flamegraph.pl, speedscope, inferno etc. can read.
+namespace GuestProfiler
+{
+	static constexpr u32 DEFAULT_SAMPLE_INTERVAL_US = 1000;
+
+	bool IsActive();
+
+	// Starts sampling. The profile will be written to output_path when stopped.
+	bool Start(std::string output_path, u32 sample_interval_us = DEFAULT_SAMPLE_INTERVAL_US, Error* error = nullptr);
+
+	// Stops sampling, symbolizes the samples and writes the folded stack file.
+	bool Stop(Error* error = nullptr);
+
+	// Returns the path the current (or last) profile is written to.
+	const std::string& GetOutputPath();
+} // namespace GuestProfiler
@@ -6,9 +6,98 @@
 #include "DebugInterface.h"
 #include "Host.h"
 
+#include <algorithm>
+#include <bit>
+
 SymbolGuardian R5900SymbolGuardian;
 SymbolGuardian R3000SymbolGuardian;
 
+namespace
+{
+	template <typename SymbolType>
+	void AddToAddressIndex(std::vector<SymbolAddressIndex::Entry>& entries, const ccc::SymbolList<SymbolType>& list)
+	{
+		entries.reserve(list.size());
+
+		// Walk the address map itself so that symbols with the same address
+		// end up in the same order the database would find them in.
+		const ccc::AddressRange all_addresses(ccc::Address(0), ccc::Address());
+		for (const auto& [address, handle] : list.handles_from_address_range(all_addresses))
+		{
+			const SymbolType* symbol = list.symbol_from_handle(handle);
+			if (!symbol)
+				continue;
+
+			SymbolAddressIndex::Entry& entry = entries.emplace_back();
+			entry.address = address;
+			entry.size = symbol->size();
+			entry.handle = symbol->raw_handle();
+			entry.name = symbol->name();
+			if constexpr (std::is_same_v<SymbolType, ccc::Function>)
+				entry.is_no_return = symbol->is_no_return;
+		}
+	}
+
+	const SymbolAddressIndex::Entry* EntryStartingAtAddress(const std::vector<SymbolAddressIndex::Entry>& entries, u32 address)
+	{
+		auto iterator = std::lower_bound(entries.begin(), entries.end(), address,
+			[](const SymbolAddressIndex::Entry& entry, u32 value) { return entry.address < value; });
+		if (iterator == entries.end() || iterator->address != address)
+			return nullptr;
+
+		return &*iterator;
+	}
+
+	const SymbolAddressIndex::Entry* EntryAfterAddress(const std::vector<SymbolAddressIndex::Entry>& entries, u32 address)
+	{
+		auto iterator = std::upper_bound(entries.begin(), entries.end(), address,
+			[](u32 value, const SymbolAddressIndex::Entry& entry) { return value < entry.address; });
+		if (iterator == entries.end())
+			return nullptr;
+
+		return &*iterator;
+	}
+
+	const SymbolAddressIndex::Entry* EntryOverlappingAddress(const std::vector<SymbolAddressIndex::Entry>& entries, u32 address)
+	{
+		auto iterator = std::upper_bound(entries.begin(), entries.end(), address,
+			[](u32 value, const SymbolAddressIndex::Entry& entry) { return value < entry.address; });
+		if (iterator == entries.begin())
+			return nullptr;
+
+		// Find the greatest element that is less than or equal to the address.
+		iterator--;
+		if (address >= iterator->address + iterator->size)
+			return nullptr;
+
+		return &*iterator;
+	}
+
+	SymbolInfo SymbolInfoFromEntry(const SymbolAddressIndex::Entry& entry, size_t type)
+	{
+		SymbolInfo info;
+		info.descriptor = static_cast<ccc::SymbolDescriptor>(1u << type);
+		info.handle = entry.handle;
+		info.name = entry.name;
+		info.address = entry.address;
+		info.size = entry.size;
+		return info;
+	}
+
+	FunctionInfo FunctionInfoFromEntry(const SymbolAddressIndex::Entry& entry)
+	{
+		FunctionInfo info;
+		info.handle = ccc::FunctionHandle(entry.handle);
+		info.name = entry.name;
+		info.address = entry.address;
+		info.size = entry.size;
+		info.is_no_return = entry.is_no_return;
+		return info;
+	}
+
+	constexpr size_t FUNCTION_LIST = std::countr_zero<u32>(ccc::FUNCTION);
+} // namespace
+
 void SymbolGuardian::Read(ReadCallback callback) const noexcept
 {
 	std::shared_lock lock(m_big_symbol_lock);
@@ -19,63 +108,100 @@ void SymbolGuardian::ReadWrite(ReadWriteCallback callback) noexcept
 {
 	std::unique_lock lock(m_big_symbol_lock);
 	callback(m_database);
+	m_address_index_dirty.store(true, std::memory_order_release);
+}
+
+std::shared_ptr<const SymbolAddressIndex> SymbolGuardian::GetAddressIndex() const
+{
+	if (m_address_index_dirty.load(std::memory_order_acquire)) [[unlikely]]
+	{
+		// Writers can't run while we hold the shared lock, so the database
+		// can't change again until the new index has been published.
+		std::shared_lock lock(m_big_symbol_lock);
+		std::unique_lock build_lock(m_address_index_build_lock);
+		if (m_address_index_dirty.load(std::memory_order_relaxed))
+		{
+			std::shared_ptr<const SymbolAddressIndex> index = BuildAddressIndex(m_database);
+			{
+				std::unique_lock index_lock(m_address_index_lock);
+				m_address_index = std::move(index);
+			}
+			m_address_index_dirty.store(false, std::memory_order_release);
+		}
+	}
+
+	std::unique_lock index_lock(m_address_index_lock);
+	return m_address_index;
+}
+
+std::shared_ptr<const SymbolAddressIndex> SymbolGuardian::BuildAddressIndex(const ccc::SymbolDatabase& database)
+{
+	std::shared_ptr<SymbolAddressIndex> index = std::make_shared<SymbolAddressIndex>();
+
+#define CCC_X(SymbolType, symbol_list) \
+	if constexpr (ccc::SymbolType::FLAGS & ccc::WITH_ADDRESS_MAP) \
+		AddToAddressIndex(index->lists[std::countr_zero<u32>(ccc::SymbolType::DESCRIPTOR)], database.symbol_list);
+	CCC_FOR_EACH_SYMBOL_TYPE_DO_X
+#undef CCC_X
+
+	return index;
 }
 
 SymbolInfo SymbolGuardian::SymbolStartingAtAddress(
 	u32 address, u32 descriptors) const
 {
-	SymbolInfo info;
-	Read([&](const ccc::SymbolDatabase& database) {
-		ccc::SymbolDescriptor descriptor;
-		const ccc::Symbol* symbol = database.symbol_starting_at_address(address, descriptors, &descriptor);
-		if (!symbol)
-			return;
+	const std::shared_ptr<const SymbolAddressIndex> index = GetAddressIndex();
+	for (size_t type = 0; type < SymbolAddressIndex::SYMBOL_TYPE_COUNT; type++)
+	{
+		if (!(descriptors & (1u << type)))
+			continue;
 
-		info.descriptor = descriptor;
-		info.handle = symbol->raw_handle();
-		info.name = symbol->name();
-		info.address = symbol->address();
-		info.size = symbol->size();
-	});
-	return info;
+		if (const SymbolAddressIndex::Entry* entry = EntryStartingAtAddress(index->lists[type], address))
+			return SymbolInfoFromEntry(*entry, type);
+	}
+
+	return SymbolInfo();
 }
 
 SymbolInfo SymbolGuardian::SymbolAfterAddress(
 	u32 address, u32 descriptors) const
 {
-	SymbolInfo info;
-	Read([&](const ccc::SymbolDatabase& database) {
-		ccc::SymbolDescriptor descriptor;
-		const ccc::Symbol* symbol = database.symbol_after_address(address, descriptors, &descriptor);
-		if (!symbol)
-			return;
+	const std::shared_ptr<const SymbolAddressIndex> index = GetAddressIndex();
+	const SymbolAddressIndex::Entry* result = nullptr;
+	size_t result_type = 0;
+	for (size_t type = 0; type < SymbolAddressIndex::SYMBOL_TYPE_COUNT; type++)
+	{
+		if (!(descriptors & (1u << type)))
+			continue;
 
-		info.descriptor = descriptor;
-		info.handle = symbol->raw_handle();
-		info.name = symbol->name();
-		info.address = symbol->address();
-		info.size = symbol->size();
-	});
-	return info;
+		const SymbolAddressIndex::Entry* entry = EntryAfterAddress(index->lists[type], address);
+		if (entry && (!result || entry->address < result->address))
+		{
+			result = entry;
+			result_type = type;
+		}
+	}
+
+	if (!result)
+		return SymbolInfo();
+
+	return SymbolInfoFromEntry(*result, result_type);
 }
 
 SymbolInfo SymbolGuardian::SymbolOverlappingAddress(
 	u32 address, u32 descriptors) const
 {
-	SymbolInfo info;
-	Read([&](const ccc::SymbolDatabase& database) {
-		ccc::SymbolDescriptor descriptor;
-		const ccc::Symbol* symbol = database.symbol_overlapping_address(address, descriptors, &descriptor);
-		if (!symbol)
-			return;
+	const std::shared_ptr<const SymbolAddressIndex> index = GetAddressIndex();
+	for (size_t type = 0; type < SymbolAddressIndex::SYMBOL_TYPE_COUNT; type++)
+	{
+		if (!(descriptors & (1u << type)))
+			continue;
 
-		info.descriptor = descriptor;
-		info.handle = symbol->raw_handle();
-		info.name = symbol->name();
-		info.address = symbol->address();
-		info.size = symbol->size();
-	});
-	return info;
+		if (const SymbolAddressIndex::Entry* entry = EntryOverlappingAddress(index->lists[type], address))
+			return SymbolInfoFromEntry(*entry, type);
+	}
+
+	return SymbolInfo();
 }
 
 SymbolInfo SymbolGuardian::SymbolWithName(
@@ -99,57 +225,34 @@ SymbolInfo SymbolGuardian::SymbolWithName(
 
 bool SymbolGuardian::FunctionExistsWithStartingAddress(u32 address) const
 {
-	bool exists = false;
-	Read([&](const ccc::SymbolDatabase& database) {
-		ccc::FunctionHandle handle = database.functions.first_handle_from_starting_address(address);
-		exists = handle.valid();
-	});
-	return exists;
+	const std::shared_ptr<const SymbolAddressIndex> index = GetAddressIndex();
+	return EntryStartingAtAddress(index->lists[FUNCTION_LIST], address) != nullptr;
 }
 
 bool SymbolGuardian::FunctionExistsThatOverlapsAddress(u32 address) const
 {
-	bool exists = false;
-	Read([&](const ccc::SymbolDatabase& database) {
-		const ccc::Function* function = database.functions.symbol_overlapping_address(address);
-		exists = function != nullptr;
-	});
-	return exists;
+	const std::shared_ptr<const SymbolAddressIndex> index = GetAddressIndex();
+	return EntryOverlappingAddress(index->lists[FUNCTION_LIST], address) != nullptr;
 }
 
 FunctionInfo SymbolGuardian::FunctionStartingAtAddress(u32 address) const
 {
-	FunctionInfo info;
-	Read([&](const ccc::SymbolDatabase& database) {
-		ccc::FunctionHandle handle = database.functions.first_handle_from_starting_address(address);
-		const ccc::Function* function = database.functions.symbol_from_handle(handle);
-		if (!function)
-			return;
+	const std::shared_ptr<const SymbolAddressIndex> index = GetAddressIndex();
+	const SymbolAddressIndex::Entry* entry = EntryStartingAtAddress(index->lists[FUNCTION_LIST], address);
+	if (!entry)
+		return FunctionInfo();
 
-		info.handle = function->handle();
-		info.name = function->name();
-		info.address = function->address();
-		info.size = function->size();
-		info.is_no_return = function->is_no_return;
-	});
-	return info;
+	return FunctionInfoFromEntry(*entry);
 }
 
 FunctionInfo SymbolGuardian::FunctionOverlappingAddress(u32 address) const
 {
-	FunctionInfo info;
-	Read([&](const ccc::SymbolDatabase& database) {
-		const ccc::Function* function = database.functions.symbol_overlapping_address(address);
-		if (!function)
-			return;
+	const std::shared_ptr<const SymbolAddressIndex> index = GetAddressIndex();
+	const SymbolAddressIndex::Entry* entry = EntryOverlappingAddress(index->lists[FUNCTION_LIST], address);
+	if (!entry)
+		return FunctionInfo();
 
-		info.handle = function->handle();
-		info.name = function->name();
-		info.address = function->address();
-		info.size = function->size();
-		info.is_no_return = function->is_no_return;
-	});
-	return info;
+	return FunctionInfoFromEntry(*entry);
 }
 
 void SymbolGuardian::GenerateFunctionHashes(ccc::SymbolDatabase& database, MemoryInterface& reader)
@@ -10,8 +10,10 @@
 #include <ccc/symbol_database.h>
 #include <ccc/symbol_file.h>
 
+#include <array>
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <thread>
@@ -34,6 +36,28 @@ struct FunctionInfo
 	bool is_no_return = false;
 };
 
+// Immutable copy of the address maps of a symbol database, so that address
+// lookups can be done without holding the symbol lock.
+struct SymbolAddressIndex
+{
+	struct Entry
+	{
+		u32 address = 0;
+		u32 size = 0;
+		u32 handle = (u32)-1;
+		bool is_no_return = false;
+		std::string name;
+	};
+
+#define CCC_X(SymbolType, symbol_list) +1
+	static constexpr size_t SYMBOL_TYPE_COUNT = 0 CCC_FOR_EACH_SYMBOL_TYPE_DO_X;
+#undef CCC_X
+
+	// One list for each symbol type, indexed by the bit number of its
+	// descriptor, sorted by address.
+	std::array<std::vector<Entry>, SYMBOL_TYPE_COUNT> lists;
+};
+
 // Guardian of the ancient symbols. This class provides a thread safe API for
 // accessing the symbol database.
 class SymbolGuardian
@@ -52,10 +76,12 @@ public:
 	// Take a shared lock on the symbol database and run the callback.
 	void Read(ReadCallback callback) const noexcept;
 
-	// Take an exclusive lock on the symbol database and run the callback.
+	// Take an exclusive lock on the symbol database and run the callback. The
+	// address index is rebuilt on the next address lookup.
 	void ReadWrite(ReadWriteCallback callback) noexcept;
 
-	// Copy commonly used attributes of a symbol into a temporary object.
+	// Copy commonly used attributes of a symbol into a temporary object. The
+	// address based lookups use the address index and don't take the lock.
 	SymbolInfo SymbolStartingAtAddress(
 		u32 address, u32 descriptors = ccc::ALL_SYMBOL_TYPES) const;
 	SymbolInfo SymbolAfterAddress(
@@ -92,8 +118,21 @@ public:
 	static const char* TranslateSymbolSourceName(const char* name);
 
 protected:
+	// Get the current address index, rebuilding it first if the database has
+	// been modified since it was last built.
+	std::shared_ptr<const SymbolAddressIndex> GetAddressIndex() const;
+
+	static std::shared_ptr<const SymbolAddressIndex> BuildAddressIndex(const ccc::SymbolDatabase& database);
+
 	ccc::SymbolDatabase m_database;
 	mutable std::shared_mutex m_big_symbol_lock;
+
+	// Only held for as long as it takes to copy or replace the pointer.
+	mutable std::mutex m_address_index_lock;
+	mutable std::shared_ptr<const SymbolAddressIndex> m_address_index;
+	// Makes sure only one thread rebuilds the index at a time.
+	mutable std::mutex m_address_index_build_lock;
+	mutable std::atomic_bool m_address_index_dirty{true};
 };
 
 extern SymbolGuardian R5900SymbolGuardian;
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include "BuildVersion.h"
 #include "GameDatabase.h"
 #include "GS/GS.h"
 #include "Host.h"
@@ -22,6 +23,7 @@
 #include <fstream>
 #include <mutex>
 #include <optional>
+#include <span>
 
 namespace GameDatabaseSchema
 {
@@ -32,15 +34,44 @@ namespace GameDatabaseSchema
 
 namespace GameDatabase
 {
+	// Header of the binary database, which is generated from the YAML on first run and kept in the cache
+	// directory. Serials are looked up through a hash-and-displace perfect hash, so nothing but the entry
+	// for the game being queried has to be decoded.
+	struct BinaryHeader
+	{
+		u32 signature;
+		u32 version;
+		u64 source_size;
+		s64 source_timestamp;
+		u32 schema;
+		u32 num_entries;
+		u32 num_buckets;
+		u32 num_slots;
+		char build_hash[48];
+	};
+	static_assert(sizeof(BinaryHeader) == 88);
+
 	static void parseAndInsert(const std::string_view serial, const ryml::NodeRef& node);
 	static void initDatabase();
+	static bool openBinaryDatabase(const FILESYSTEM_STAT_DATA& source_sd);
+	static void writeBinaryDatabase(const FILESYSTEM_STAT_DATA& source_sd);
+	static const GameDatabaseSchema::GameEntry* findBinaryEntry(const std::string& serial);
 } // namespace GameDatabase
 
 static constexpr char GAMEDB_YAML_FILE_NAME[] = "GameIndex.yaml";
+static constexpr char GAMEDB_BINARY_FILE_NAME[] = "gamedb.cache";
+static constexpr u32 GAMEDB_BINARY_SIGNATURE = 0x42444750; // PGDB
+static constexpr u32 GAMEDB_BINARY_VERSION = 1;
+static constexpr u32 GAMEDB_BINARY_EMPTY_SLOT = 0xFFFFFFFFu;
 
 static std::unordered_map<std::string, GameDatabaseSchema::GameEntry> s_game_db;
 static std::once_flag s_load_once_flag;
 
+// When the binary database is in use, s_game_db only holds the entries which have been decoded so far.
+static std::span<const u8> s_binary_data;
+static GameDatabase::BinaryHeader s_binary_header;
+static std::mutex s_binary_mutex;
+
 std::string GameDatabaseSchema::GameEntry::memcardFiltersAsString() const
 {
 	return fmt::to_string(fmt::join(memcardFilters, "/"));
@@ -1061,13 +1092,424 @@ void GameDatabase::initDatabase()
 	}
 }
 
+static std::string getBinaryDatabasePath()
+{
+	return EmuFolders::Cache.empty() ? std::string() : Path::Combine(EmuFolders::Cache, GAMEDB_BINARY_FILE_NAME);
+}
+
+static u32 getBinarySchema()
+{
+	// Enums are stored as raw values, so changing any of them has to throw the file away, even if the build
+	// hash isn't available.
+	return (static_cast<u32>(GamefixId_COUNT) << 24) | (static_cast<u32>(SpeedHack::MaxCount) << 16) |
+		   (static_cast<u32>(GameDatabaseSchema::GSHWFixId::Count) << 8) | static_cast<u32>(FPRoundMode::MaxCount);
+}
+
+static u32 hashBinarySerial(const std::string_view serial, u32 seed)
+{
+	u64 hash = 0xCBF29CE484222325ULL ^ (static_cast<u64>(seed) * 0x9E3779B97F4A7C15ULL);
+	for (const char ch : serial)
+	{
+		hash ^= static_cast<u8>(ch);
+		hash *= 0x100000001B3ULL;
+	}
+
+	return static_cast<u32>(hash ^ (hash >> 32));
+}
+
+template <typename T>
+static void writeBinaryValue(std::vector<u8>& out, T value)
+{
+	const size_t pos = out.size();
+	out.resize(pos + sizeof(T));
+	std::memcpy(&out[pos], &value, sizeof(T));
+}
+
+static void writeBinaryString(std::vector<u8>& out, const std::string_view str)
+{
+	writeBinaryValue<u32>(out, static_cast<u32>(str.size()));
+	out.insert(out.end(), str.begin(), str.end());
+}
+
+struct BinaryDatabaseReader
+{
+	const u8* ptr;
+	const u8* end;
+	bool ok = true;
+
+	template <typename T>
+	T read()
+	{
+		T value{};
+		if (!ok || static_cast<size_t>(end - ptr) < sizeof(T))
+		{
+			ok = false;
+			return value;
+		}
+
+		std::memcpy(&value, ptr, sizeof(T));
+		ptr += sizeof(T);
+		return value;
+	}
+
+	std::string_view readString()
+	{
+		const u32 length = read<u32>();
+		if (!ok || static_cast<size_t>(end - ptr) < length)
+		{
+			ok = false;
+			return {};
+		}
+
+		const std::string_view str(reinterpret_cast<const char*>(ptr), length);
+		ptr += length;
+		return str;
+	}
+
+	template <typename T>
+	bool readEnum(T* value, s32 min_value, s32 max_value)
+	{
+		const s32 raw = read<s32>();
+		ok = ok && raw >= min_value && raw <= max_value;
+		*value = static_cast<T>(raw);
+		return ok;
+	}
+};
+
+static void encodeGameEntry(std::vector<u8>& out, const std::string& serial, const GameDatabaseSchema::GameEntry& entry)
+{
+	writeBinaryString(out, serial);
+	writeBinaryString(out, entry.name);
+	writeBinaryString(out, entry.name_sort);
+	writeBinaryString(out, entry.name_en);
+	writeBinaryString(out, entry.region);
+	writeBinaryValue<s32>(out, static_cast<s32>(entry.compat));
+	writeBinaryValue<s32>(out, static_cast<s32>(entry.eeRoundMode));
+	writeBinaryValue<s32>(out, static_cast<s32>(entry.eeDivRoundMode));
+	writeBinaryValue<s32>(out, static_cast<s32>(entry.vu0RoundMode));
+	writeBinaryValue<s32>(out, static_cast<s32>(entry.vu1RoundMode));
+	writeBinaryValue<s32>(out, static_cast<s32>(entry.eeClampMode));
+	writeBinaryValue<s32>(out, static_cast<s32>(entry.vu0ClampMode));
+	writeBinaryValue<s32>(out, static_cast<s32>(entry.vu1ClampMode));
+
+	writeBinaryValue<u32>(out, static_cast<u32>(entry.gameFixes.size()));
+	for (const GamefixId id : entry.gameFixes)
+		writeBinaryValue<s32>(out, static_cast<s32>(id));
+
+	writeBinaryValue<u32>(out, static_cast<u32>(entry.speedHacks.size()));
+	for (const auto& [id, value] : entry.speedHacks)
+	{
+		writeBinaryValue<s32>(out, static_cast<s32>(id));
+		writeBinaryValue<s32>(out, value);
+	}
+
+	writeBinaryValue<u32>(out, static_cast<u32>(entry.gsHWFixes.size()));
+	for (const auto& [id, value] : entry.gsHWFixes)
+	{
+		writeBinaryValue<s32>(out, static_cast<s32>(id));
+		writeBinaryValue<s32>(out, value);
+	}
+
+	writeBinaryValue<u32>(out, static_cast<u32>(entry.memcardFilters.size()));
+	for (const std::string& filter : entry.memcardFilters)
+		writeBinaryString(out, filter);
+
+	writeBinaryValue<u32>(out, static_cast<u32>(entry.patches.size()));
+	for (const auto& [crc, patch] : entry.patches)
+	{
+		writeBinaryValue<u32>(out, crc);
+		writeBinaryString(out, patch);
+	}
+
+	writeBinaryValue<u32>(out, static_cast<u32>(entry.dynaPatches.size()));
+	for (const Patch::DynamicPatch& patch : entry.dynaPatches)
+	{
+		writeBinaryValue<u32>(out, static_cast<u32>(patch.pattern.size()));
+		for (const Patch::DynamicPatchEntry& pe : patch.pattern)
+		{
+			writeBinaryValue<u32>(out, pe.offset);
+			writeBinaryValue<u32>(out, pe.value);
+		}
+		writeBinaryValue<u32>(out, static_cast<u32>(patch.replacement.size()));
+		for (const Patch::DynamicPatchEntry& pe : patch.replacement)
+		{
+			writeBinaryValue<u32>(out, pe.offset);
+			writeBinaryValue<u32>(out, pe.value);
+		}
+	}
+}
+
+static bool decodeGameEntry(BinaryDatabaseReader& reader, GameDatabaseSchema::GameEntry* entry)
+{
+	using namespace GameDatabaseSchema;
+
+	static constexpr s32 MAX_ROUND_MODE = static_cast<s32>(FPRoundMode::MaxCount);
+	entry->name = reader.readString();
+	entry->name_sort = reader.readString();
+	entry->name_en = reader.readString();
+	entry->region = reader.readString();
+	if (!reader.readEnum(&entry->compat, 0, static_cast<s32>(Compatibility::Perfect)) ||
+		!reader.readEnum(&entry->eeRoundMode, 0, MAX_ROUND_MODE) ||
+		!reader.readEnum(&entry->eeDivRoundMode, 0, MAX_ROUND_MODE) ||
+		!reader.readEnum(&entry->vu0RoundMode, 0, MAX_ROUND_MODE) ||
+		!reader.readEnum(&entry->vu1RoundMode, 0, MAX_ROUND_MODE) ||
+		!reader.readEnum(&entry->eeClampMode, static_cast<s32>(ClampMode::Undefined), static_cast<s32>(ClampMode::Full)) ||
+		!reader.readEnum(&entry->vu0ClampMode, static_cast<s32>(ClampMode::Undefined), static_cast<s32>(ClampMode::Full)) ||
+		!reader.readEnum(&entry->vu1ClampMode, static_cast<s32>(ClampMode::Undefined), static_cast<s32>(ClampMode::Full)))
+	{
+		return false;
+	}
+
+	const u32 num_game_fixes = reader.read<u32>();
+	for (u32 i = 0; i < num_game_fixes && reader.ok; i++)
+	{
+		GamefixId id;
+		if (reader.readEnum(&id, GamefixId_FIRST, GamefixId_COUNT - 1))
+			entry->gameFixes.push_back(id);
+	}
+
+	const u32 num_speed_hacks = reader.read<u32>();
+	for (u32 i = 0; i < num_speed_hacks && reader.ok; i++)
+	{
+		SpeedHack id;
+		if (reader.readEnum(&id, 0, static_cast<s32>(SpeedHack::MaxCount) - 1))
+			entry->speedHacks.emplace_back(id, reader.read<s32>());
+	}
+
+	const u32 num_gs_hw_fixes = reader.read<u32>();
+	for (u32 i = 0; i < num_gs_hw_fixes && reader.ok; i++)
+	{
+		GSHWFixId id;
+		if (reader.readEnum(&id, 0, static_cast<s32>(GSHWFixId::Count) - 1))
+			entry->gsHWFixes.emplace_back(id, reader.read<s32>());
+	}
+
+	const u32 num_memcard_filters = reader.read<u32>();
+	for (u32 i = 0; i < num_memcard_filters && reader.ok; i++)
+		entry->memcardFilters.emplace_back(reader.readString());
+
+	const u32 num_patches = reader.read<u32>();
+	for (u32 i = 0; i < num_patches && reader.ok; i++)
+	{
+		const u32 crc = reader.read<u32>();
+		entry->patches.emplace(crc, reader.readString());
+	}
+
+	const u32 num_dyna_patches = reader.read<u32>();
+	for (u32 i = 0; i < num_dyna_patches && reader.ok; i++)
+	{
+		Patch::DynamicPatch& patch = entry->dynaPatches.emplace_back();
+		const u32 num_pattern = reader.read<u32>();
+		for (u32 j = 0; j < num_pattern && reader.ok; j++)
+		{
+			const u32 offset = reader.read<u32>();
+			patch.pattern.push_back({offset, reader.read<u32>()});
+		}
+		const u32 num_replacement = reader.read<u32>();
+		for (u32 j = 0; j < num_replacement && reader.ok; j++)
+		{
+			const u32 offset = reader.read<u32>();
+			patch.replacement.push_back({offset, reader.read<u32>()});
+		}
+	}
+
+	return reader.ok;
+}
+
+bool GameDatabase::openBinaryDatabase(const FILESYSTEM_STAT_DATA& source_sd)
+{
+	const std::string path(getBinaryDatabasePath());
+	if (path.empty())
+		return false;
+
+	s_binary_data = FileSystem::MapBinaryFileForRead(path.c_str());
+	if (s_binary_data.empty())
+		return false;
+
+	if (s_binary_data.size() >= sizeof(BinaryHeader))
+		std::memcpy(&s_binary_header, s_binary_data.data(), sizeof(BinaryHeader));
+	else
+		s_binary_header = {};
+
+	const std::string_view build_hash(
+		s_binary_header.build_hash, strnlen(s_binary_header.build_hash, sizeof(s_binary_header.build_hash)));
+	const u64 tables_size = (static_cast<u64>(s_binary_header.num_buckets) + s_binary_header.num_slots) * sizeof(u32);
+	if (s_binary_header.signature != GAMEDB_BINARY_SIGNATURE || s_binary_header.version != GAMEDB_BINARY_VERSION ||
+		s_binary_header.schema != getBinarySchema() || build_hash != BuildVersion::GitHash ||
+		s_binary_header.source_size != static_cast<u64>(source_sd.Size) ||
+		s_binary_header.source_timestamp != static_cast<s64>(source_sd.ModificationTime) ||
+		s_binary_header.num_buckets == 0 || s_binary_header.num_slots == 0 ||
+		(s_binary_data.size() - sizeof(BinaryHeader)) < tables_size)
+	{
+		Console.WriteLn("GameDB: Binary cache is out of date, rebuilding.");
+		FileSystem::UnmapFile(s_binary_data);
+		s_binary_data = {};
+		return false;
+	}
+
+	return true;
+}
+
+void GameDatabase::writeBinaryDatabase(const FILESYSTEM_STAT_DATA& source_sd)
+{
+	const std::string path(getBinaryDatabasePath());
+	if (path.empty())
+		return;
+
+	Common::Timer timer;
+
+	std::vector<const std::string*> serials;
+	serials.reserve(s_game_db.size());
+	for (const auto& it : s_game_db)
+		serials.push_back(&it.first);
+
+	BinaryHeader header = {};
+	header.signature = GAMEDB_BINARY_SIGNATURE;
+	header.version = GAMEDB_BINARY_VERSION;
+	header.source_size = static_cast<u64>(source_sd.Size);
+	header.source_timestamp = static_cast<s64>(source_sd.ModificationTime);
+	header.schema = getBinarySchema();
+	header.num_entries = static_cast<u32>(serials.size());
+	header.num_buckets = std::max<u32>(header.num_entries / 4, 1);
+	header.num_slots = std::max<u32>(header.num_entries + header.num_entries / 8, 1);
+	StringUtil::Strlcpy(header.build_hash, BuildVersion::GitHash, sizeof(header.build_hash));
+
+	// Hash and displace: place the biggest buckets first, searching for a seed which puts all of their serials
+	// into free slots.
+	std::vector<std::vector<u32>> buckets(header.num_buckets);
+	for (u32 i = 0; i < header.num_entries; i++)
+		buckets[hashBinarySerial(*serials[i], 0) % header.num_buckets].push_back(i);
+
+	std::vector<u32> bucket_order(header.num_buckets);
+	for (u32 i = 0; i < header.num_buckets; i++)
+		bucket_order[i] = i;
+	std::sort(bucket_order.begin(), bucket_order.end(),
+		[&buckets](u32 lhs, u32 rhs) { return buckets[lhs].size() > buckets[rhs].size(); });
+
+	std::vector<u32> seeds(header.num_buckets, 0);
+	std::vector<u32> slot_entries(header.num_slots, GAMEDB_BINARY_EMPTY_SLOT);
+	std::vector<u32> bucket_slots;
+	for (const u32 bucket : bucket_order)
+	{
+		if (buckets[bucket].empty())
+			break;
+
+		u32 seed = 1;
+		for (; seed < 0x100000; seed++)
+		{
+			bucket_slots.clear();
+			for (const u32 entry : buckets[bucket])
+			{
+				const u32 slot = hashBinarySerial(*serials[entry], seed) % header.num_slots;
+				if (slot_entries[slot] != GAMEDB_BINARY_EMPTY_SLOT ||
+					std::find(bucket_slots.begin(), bucket_slots.end(), slot) != bucket_slots.end())
+				{
+					break;
+				}
+
+				bucket_slots.push_back(slot);
+			}
+
+			if (bucket_slots.size() == buckets[bucket].size())
+				break;
+		}
+
+		if (bucket_slots.size() != buckets[bucket].size())
+		{
+			Console.Error("GameDB: Failed to build perfect hash for binary cache.");
+			return;
+		}
+
+		seeds[bucket] = seed;
+		for (size_t i = 0; i < bucket_slots.size(); i++)
+			slot_entries[bucket_slots[i]] = buckets[bucket][i];
+	}
+
+	std::vector<u8> entries;
+	std::vector<u32> slots(header.num_slots, GAMEDB_BINARY_EMPTY_SLOT);
+	for (u32 i = 0; i < header.num_slots; i++)
+	{
+		if (slot_entries[i] == GAMEDB_BINARY_EMPTY_SLOT)
+			continue;
+
+		const std::string& serial = *serials[slot_entries[i]];
+		slots[i] = static_cast<u32>(entries.size());
+		encodeGameEntry(entries, serial, s_game_db.find(serial)->second);
+	}
+
+	std::vector<u8> data;
+	data.reserve(sizeof(header) + (seeds.size() + slots.size()) * sizeof(u32) + entries.size());
+	data.resize(sizeof(header));
+	std::memcpy(data.data(), &header, sizeof(header));
+	for (const u32 seed : seeds)
+		writeBinaryValue<u32>(data, seed);
+	for (const u32 slot : slots)
+		writeBinaryValue<u32>(data, slot);
+	data.insert(data.end(), entries.begin(), entries.end());
+
+	// write to a temporary file first, another process could be reading the old one
+	Error error;
+	const std::string temp_path(path + ".tmp");
+	if (!FileSystem::WriteBinaryFile(temp_path.c_str(), data.data(), data.size()) ||
+		!FileSystem::RenamePath(temp_path.c_str(), path.c_str(), &error))
+	{
+		Console.Error(fmt::format("GameDB: Failed to write binary cache: {}", error.GetDescription()));
+		FileSystem::DeleteFilePath(temp_path.c_str());
+		return;
+	}
+
+	Console.WriteLn("GameDB: Wrote binary cache (%zu bytes) in %.2fms", data.size(), timer.GetTimeMilliseconds());
+}
+
+const GameDatabaseSchema::GameEntry* GameDatabase::findBinaryEntry(const std::string& serial)
+{
+	const u8* tables = s_binary_data.data() + sizeof(BinaryHeader);
+	const u8* entries = tables + (static_cast<size_t>(s_binary_header.num_buckets) + s_binary_header.num_slots) * sizeof(u32);
+
+	u32 seed, offset;
+	std::memcpy(&seed, tables + (hashBinarySerial(serial, 0) % s_binary_header.num_buckets) * sizeof(u32), sizeof(seed));
+	std::memcpy(&offset,
+		tables + (s_binary_header.num_buckets + (hashBinarySerial(serial, seed) % s_binary_header.num_slots)) * sizeof(u32),
+		sizeof(offset));
+	if (offset == GAMEDB_BINARY_EMPTY_SLOT || offset >= static_cast<size_t>(s_binary_data.data() + s_binary_data.size() - entries))
+		return nullptr;
+
+	// Unknown serials still land in some slot, so check it's actually the one we're after.
+	BinaryDatabaseReader reader{entries + offset, s_binary_data.data() + s_binary_data.size()};
+	if (reader.readString() != serial)
+		return nullptr;
+
+	GameDatabaseSchema::GameEntry entry;
+	if (!decodeGameEntry(reader, &entry))
+	{
+		Console.Error(fmt::format("GameDB: Corrupted binary cache entry for '{}'.", serial));
+		return nullptr;
+	}
+
+	return &s_game_db.emplace(serial, std::move(entry)).first->second;
+}
+
 void GameDatabase::ensureLoaded()
 {
 	std::call_once(s_load_once_flag, []() {
 		Common::Timer timer;
 		Console.WriteLn(fmt::format("GameDB: Has not been initialized yet, initializing..."));
+
+		FILESYSTEM_STAT_DATA source_sd;
+		const std::string source_path(Path::Combine(EmuFolders::Resources, GAMEDB_YAML_FILE_NAME));
+		const bool has_source = FileSystem::StatFile(source_path.c_str(), &source_sd);
+		if (has_source && openBinaryDatabase(source_sd))
+		{
+			Console.WriteLn("GameDB: %u games on record (opened binary cache in %.2fms)", s_binary_header.num_entries,
+				timer.GetTimeMilliseconds());
+			return;
+		}
+
 		initDatabase();
 		Console.WriteLn("GameDB: %zu games on record (loaded in %.2fms)", s_game_db.size(), timer.GetTimeMilliseconds());
+
+		if (has_source && !s_game_db.empty())
+			writeBinaryDatabase(source_sd);
 	});
 }
 
@@ -1075,8 +1517,17 @@ const GameDatabaseSchema::GameEntry* GameDatabase::findGame(const std::string_vi
 {
 	GameDatabase::ensureLoaded();
 
-	auto iter = s_game_db.find(StringUtil::toLower(serial));
-	return (iter != s_game_db.end()) ? &iter->second : nullptr;
+	const std::string lserial(StringUtil::toLower(serial));
+	if (s_binary_data.empty())
+	{
+		auto iter = s_game_db.find(lserial);
+		return (iter != s_game_db.end()) ? &iter->second : nullptr;
+	}
+
+	// Entries are decoded the first time they're asked for, and kept around since callers hold on to them.
+	std::unique_lock lock(s_binary_mutex);
+	auto iter = s_game_db.find(lserial);
+	return (iter != s_game_db.end()) ? &iter->second : findBinaryEntry(lserial);
 }
 
 bool GameDatabase::TrackHash::parseHash(const std::string_view str)
@@ -9,6 +9,7 @@
 #include "VMManager.h"
 
 #include "common/Assertions.h"
+#include "common/BitUtils.h"
 #include "common/Console.h"
 #include "common/FileSystem.h"
 #include "common/Error.h"
@@ -16,16 +17,23 @@
 #include "common/HeterogeneousContainers.h"
 #include "common/Path.h"
 #include "common/ProgressCallback.h"
-#include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cctype>
+#include <cstddef>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <fstream>
+#include <optional>
+#include <span>
 #include <string_view>
+#include <thread>
 #include <utility>
 
 #ifdef _WIN32
@@ -37,13 +45,18 @@ namespace GameList
 	enum : u32
 	{
 		GAME_LIST_CACHE_SIGNATURE = 0x45434C47,
-		GAME_LIST_CACHE_VERSION = 34,
+		GAME_LIST_CACHE_VERSION = 35,
+		GAME_LIST_CACHE_RECORD_DELETED = (1 << 0),
+		GAME_LIST_CACHE_MIN_BUCKETS = 16,
+		GAME_LIST_CACHE_COMPACT_THRESHOLD = 64,
 
 
 		PLAYED_TIME_SERIAL_LENGTH = 32,
 		PLAYED_TIME_LAST_TIME_LENGTH = 20, // uint64
 		PLAYED_TIME_TOTAL_TIME_LENGTH = 20, // uint64
 		PLAYED_TIME_LINE_LENGTH = PLAYED_TIME_SERIAL_LENGTH + 1 + PLAYED_TIME_LAST_TIME_LENGTH + 1 + PLAYED_TIME_TOTAL_TIME_LENGTH,
+
+		MAX_SCAN_THREADS = 8,
 	};
 
 	struct PlayedTimeEntry
@@ -52,9 +65,50 @@ namespace GameList
 		std::time_t total_played_time;
 	};
 
-	using CacheMap = UnorderedStringMap<Entry>;
 	using PlayedTimeMap = UnorderedStringMap<PlayedTimeEntry>;
 
+	// The cache file starts with an indexed table (fixed-size records, open addressed path hash buckets and a
+	// string pool), which can be looked up straight from a read-only mapping. Entries scanned later are appended
+	// after the table, each record followed by its own strings. Replaced records are flagged as deleted in place,
+	// and the whole thing is rebuilt into a single table once enough of it is stale.
+	struct CacheString
+	{
+		u32 offset;
+		u32 length;
+	};
+
+	struct CacheHeader
+	{
+		u32 signature;
+		u32 version;
+		u32 num_records;
+		u32 num_buckets;
+		u32 num_deleted_records;
+		u32 reserved;
+		u64 strings_offset;
+		u64 strings_size;
+		u64 appended_offset;
+	};
+	static_assert(sizeof(CacheHeader) == 48);
+
+	struct CacheRecord
+	{
+		u64 path_hash;
+		u64 total_size;
+		u64 last_modified_time;
+		u32 crc;
+		u8 type;
+		u8 region;
+		u8 compatibility_rating;
+		u8 flags;
+		CacheString path;
+		CacheString serial;
+		CacheString title;
+		CacheString title_sort;
+		CacheString title_en;
+	};
+	static_assert(sizeof(CacheRecord) == 72);
+
 	static bool IsScannableFilename(const std::string_view path);
 
 	static bool GetIsoSerialAndCRC(const std::string& path, s32* disc_type, std::string* serial, u32* crc);
@@ -70,12 +124,16 @@ namespace GameList
 		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini);
 
 	static void LoadCache();
-	static bool LoadEntriesFromCache(std::FILE* stream);
+	static bool ParseCache();
+	static void UnloadCache();
+	static std::optional<u64> FindCacheRecord(const std::string_view path);
+	static bool ReadCacheRecord(u64 offset, GameList::Entry* entry);
 	static bool OpenCacheForWriting();
 	static bool WriteEntryToCache(const GameList::Entry* entry);
+	static void MarkCacheRecordDeleted(u64 offset);
 	static void CloseCacheFileStream();
 	static void DeleteCacheFile();
-	static void RewriteCacheFile();
+	static void CompactCacheFile();
 
 	static std::string GetPlayedTimeFile();
 	static bool ParsePlayedTimeLine(char* line, std::string& serial, PlayedTimeEntry& entry);
@@ -91,7 +149,10 @@ namespace GameList
 
 static std::vector<GameList::Entry> s_entries;
 static std::recursive_mutex s_mutex;
-static GameList::CacheMap s_cache_map;
+static std::span<const u8> s_cache_data;
+static GameList::CacheHeader s_cache_header = {};
+static UnorderedStringMap<u64> s_cache_appended_records;
+static u32 s_cache_stale_records = 0;
 static std::FILE* s_cache_write_stream = nullptr;
 
 const char* GameList::EntryTypeToString(EntryType type, bool translate)
@@ -255,20 +316,15 @@ void GameList::FillBootParametersForEntry(VMBootParameters* params, const Entry*
 
 bool GameList::GetIsoSerialAndCRC(const std::string& path, s32* disc_type, std::string* serial, u32* crc)
 {
+	// Opens its own image and reader, so this can run on several scanner threads at once.
+	// TODO: we could include the version in the game list?
 	Error error;
-
-	// This isn't great, we really want to make it all thread-local...
-	CDVD = &CDVDapi_Iso;
-	if (!CDVD->open(path, &error))
+	if (!cdvdGetImageDiscInfo(path, disc_type, serial, crc, &error))
 	{
-		Console.Error(fmt::format("(GameList::GetIsoSerialAndCRC) CDVD open of '{}' failed: {}", path, error.GetDescription()));
+		Console.Error(fmt::format("(GameList::GetIsoSerialAndCRC) Opening '{}' failed: {}", path, error.GetDescription()));
 		return false;
 	}
 
-	// TODO: we could include the version in the game list?
-	*disc_type = DoCDVDdetectDiskType();
-	cdvdGetDiscInfo(serial, nullptr, nullptr, crc, nullptr);
-	DoCDVDclose();
 	return true;
 }
 
@@ -447,133 +503,235 @@ bool GameList::PopulateEntryFromPath(const std::string& path, GameList::Entry* e
 
 bool GameList::GetGameListEntryFromCache(const std::string& path, GameList::Entry* entry)
 {
-	auto iter = s_cache_map.find(path);
-	if (iter == s_cache_map.end())
-		return false;
-
-	*entry = std::move(iter->second);
-	s_cache_map.erase(iter);
-	return true;
+	const std::optional<u64> offset = FindCacheRecord(path);
+	return (offset.has_value() && ReadCacheRecord(offset.value(), entry));
 }
 
-static bool ReadString(std::FILE* stream, std::string* dest)
+static u64 HashCachePath(const std::string_view path)
 {
-	u32 size;
-	if (std::fread(&size, sizeof(size), 1, stream) != 1)
-		return false;
+	// FNV-1a, this ends up in the cache file so it has to be stable.
+	u64 hash = 0xCBF29CE484222325ULL;
+	for (const char ch : path)
+	{
+		hash ^= static_cast<u8>(ch);
+		hash *= 0x100000001B3ULL;
+	}
 
-	dest->resize(size);
-	if (size > 0 && std::fread(dest->data(), size, 1, stream) != 1)
-		return false;
+	return hash;
+}
 
-	return true;
+static u64 GetCacheBucketsOffset(const GameList::CacheHeader& header)
+{
+	return sizeof(GameList::CacheHeader) + static_cast<u64>(header.num_records) * sizeof(GameList::CacheRecord);
 }
 
-static bool ReadU8(std::FILE* stream, u8* dest)
+static u64 GetAppendedStringsSize(const GameList::CacheRecord& rec)
 {
-	return std::fread(dest, sizeof(u8), 1, stream) > 0;
+	return static_cast<u64>(rec.path.length) + rec.serial.length + rec.title.length + rec.title_sort.length +
+		   rec.title_en.length;
 }
 
-static bool ReadU32(std::FILE* stream, u32* dest)
+static bool GetCacheRecordAt(u64 offset, GameList::CacheRecord* rec)
 {
-	return std::fread(dest, sizeof(u32), 1, stream) > 0;
+	if (offset > s_cache_data.size() || (s_cache_data.size() - offset) < sizeof(GameList::CacheRecord))
+		return false;
+
+	std::memcpy(rec, s_cache_data.data() + offset, sizeof(GameList::CacheRecord));
+	return true;
 }
 
-static bool ReadU64(std::FILE* stream, u64* dest)
+static bool GetCacheString(const GameList::CacheString& str, u64 base, u64 size, std::string_view* dest)
 {
-	return std::fread(dest, sizeof(u64), 1, stream) > 0;
+	if (str.offset > size || str.length > (size - str.offset))
+		return false;
+
+	*dest = std::string_view(reinterpret_cast<const char*>(s_cache_data.data() + base + str.offset), str.length);
+	return true;
 }
 
-static bool WriteString(std::FILE* stream, const std::string& str)
+static void GetCacheRecordStrings(u64 offset, const GameList::CacheRecord& rec, u64* base, u64* size)
 {
-	const u32 size = static_cast<u32>(str.size());
-	return (std::fwrite(&size, sizeof(size), 1, stream) > 0 && (size == 0 || std::fwrite(str.data(), size, 1, stream) > 0));
+	if (offset < s_cache_header.appended_offset)
+	{
+		*base = s_cache_header.strings_offset;
+		*size = s_cache_header.strings_size;
+	}
+	else
+	{
+		*base = offset + sizeof(GameList::CacheRecord);
+		*size = GetAppendedStringsSize(rec);
+	}
 }
 
-static bool WriteU8(std::FILE* stream, u8 dest)
+static void FillCacheRecord(const GameList::Entry& entry, GameList::CacheRecord* rec, std::string* strings)
 {
-	return std::fwrite(&dest, sizeof(u8), 1, stream) > 0;
+	const auto add_string = [strings](GameList::CacheString& cs, const std::string& str) {
+		cs.offset = static_cast<u32>(strings->size());
+		cs.length = static_cast<u32>(str.size());
+		strings->append(str);
+	};
+
+	*rec = {};
+	rec->path_hash = HashCachePath(entry.path);
+	rec->total_size = entry.total_size;
+	rec->last_modified_time = static_cast<u64>(entry.last_modified_time);
+	rec->crc = entry.crc;
+	rec->type = static_cast<u8>(entry.type);
+	rec->region = static_cast<u8>(entry.region);
+	rec->compatibility_rating = static_cast<u8>(entry.compatibility_rating);
+	add_string(rec->path, entry.path);
+	add_string(rec->serial, entry.serial);
+	add_string(rec->title, entry.title);
+	add_string(rec->title_sort, entry.title_sort);
+	add_string(rec->title_en, entry.title_en);
 }
 
-static bool WriteU32(std::FILE* stream, u32 dest)
+static std::string GetCacheFilename()
 {
-	return std::fwrite(&dest, sizeof(u32), 1, stream) > 0;
+	return Path::Combine(EmuFolders::Cache, "gamelist.cache");
 }
 
-static bool WriteU64(std::FILE* stream, u64 dest)
+void GameList::LoadCache()
 {
-	return std::fwrite(&dest, sizeof(u64), 1, stream) > 0;
+	UnloadCache();
+
+	const std::string cache_filename(GetCacheFilename());
+	s_cache_data = FileSystem::MapBinaryFileForRead(cache_filename.c_str());
+	if (s_cache_data.empty())
+		return;
+
+	if (!ParseCache())
+	{
+		Console.Warning("Deleting corrupted cache file '%s'", cache_filename.c_str());
+		DeleteCacheFile();
+		return;
+	}
 }
 
-bool GameList::LoadEntriesFromCache(std::FILE* stream)
+bool GameList::ParseCache()
 {
-	u32 file_signature, file_version;
-	s64 start_pos, file_size;
-	if (!ReadU32(stream, &file_signature) || !ReadU32(stream, &file_version) || file_signature != GAME_LIST_CACHE_SIGNATURE ||
-		file_version != GAME_LIST_CACHE_VERSION || (start_pos = FileSystem::FTell64(stream)) < 0 ||
-		FileSystem::FSeek64(stream, 0, SEEK_END) != 0 || (file_size = FileSystem::FTell64(stream)) < 0 ||
-		FileSystem::FSeek64(stream, start_pos, SEEK_SET) != 0)
+	const u64 size = s_cache_data.size();
+	if (size < sizeof(CacheHeader))
+		return false;
+
+	std::memcpy(&s_cache_header, s_cache_data.data(), sizeof(CacheHeader));
+	if (s_cache_header.signature != GAME_LIST_CACHE_SIGNATURE || s_cache_header.version != GAME_LIST_CACHE_VERSION ||
+		(s_cache_header.num_buckets & (s_cache_header.num_buckets - 1)) != 0 ||
+		(s_cache_header.num_buckets == 0 && s_cache_header.num_records != 0) ||
+		s_cache_header.strings_offset < GetCacheBucketsOffset(s_cache_header) + s_cache_header.num_buckets * sizeof(u32) ||
+		s_cache_header.strings_offset > size || s_cache_header.strings_size > (size - s_cache_header.strings_offset) ||
+		s_cache_header.appended_offset < (s_cache_header.strings_offset + s_cache_header.strings_size) ||
+		s_cache_header.appended_offset > size)
 	{
 		Console.Warning("Game list cache is corrupted");
 		return false;
 	}
 
-	while (FileSystem::FTell64(stream) != file_size)
+	// The table is used as-is, only the appended records need indexing.
+	s_cache_stale_records = s_cache_header.num_deleted_records;
+	for (u64 offset = s_cache_header.appended_offset; offset != size;)
 	{
-		std::string path;
-		GameList::Entry ge;
-
-		u8 type;
-		u8 region;
-		u8 compatibility_rating;
-		u64 last_modified_time;
-
-		if (!ReadString(stream, &path) || !ReadString(stream, &ge.serial) || !ReadString(stream, &ge.title) || !ReadString(stream, &ge.title_sort) ||
-			!ReadString(stream, &ge.title_en) || !ReadU8(stream, &type) || !ReadU8(stream, &region) || !ReadU64(stream, &ge.total_size) ||
-			!ReadU64(stream, &last_modified_time) || !ReadU32(stream, &ge.crc) || !ReadU8(stream, &compatibility_rating) ||
-			region >= static_cast<u8>(Region::Count) || type >= static_cast<u8>(EntryType::Count) ||
-			compatibility_rating > static_cast<u8>(CompatibilityRating::Perfect))
+		CacheRecord rec;
+		std::string_view path;
+		if (!GetCacheRecordAt(offset, &rec) ||
+			Common::AlignUpPow2(offset + sizeof(CacheRecord) + GetAppendedStringsSize(rec), 8) > size ||
+			!GetCacheString(rec.path, offset + sizeof(CacheRecord), GetAppendedStringsSize(rec), &path))
 		{
 			Console.Warning("Game list cache entry is corrupted");
 			return false;
 		}
 
-		ge.path = path;
-		ge.region = static_cast<Region>(region);
-		ge.type = static_cast<EntryType>(type);
-		ge.compatibility_rating = static_cast<CompatibilityRating>(compatibility_rating);
-		ge.last_modified_time = static_cast<std::time_t>(last_modified_time);
+		if (!(rec.flags & GAME_LIST_CACHE_RECORD_DELETED))
+			s_cache_appended_records.insert_or_assign(std::string(path), offset);
 
-		auto iter = s_cache_map.find(ge.path);
-		if (iter != s_cache_map.end())
-			iter->second = std::move(ge);
-		else
-			s_cache_map.emplace(std::move(path), std::move(ge));
+		s_cache_stale_records++;
+		offset = Common::AlignUpPow2(offset + sizeof(CacheRecord) + GetAppendedStringsSize(rec), 8);
 	}
 
 	return true;
 }
 
-static std::string GetCacheFilename()
+void GameList::UnloadCache()
 {
-	return Path::Combine(EmuFolders::Cache, "gamelist.cache");
+	if (!s_cache_data.empty())
+	{
+		FileSystem::UnmapFile(s_cache_data);
+		s_cache_data = {};
+	}
+
+	s_cache_header = {};
+	s_cache_appended_records.clear();
+	s_cache_stale_records = 0;
 }
 
-void GameList::LoadCache()
+std::optional<u64> GameList::FindCacheRecord(const std::string_view path)
 {
-	const std::string cache_filename(GetCacheFilename());
-	auto stream = FileSystem::OpenManagedCFile(cache_filename.c_str(), "rb");
-	if (!stream)
-		return;
+	if (s_cache_data.empty())
+		return std::nullopt;
+
+	// Appended records are always newer than the table.
+	if (const auto iter = s_cache_appended_records.find(path); iter != s_cache_appended_records.end())
+		return iter->second;
+
+	const u32 num_buckets = s_cache_header.num_buckets;
+	const u64 buckets_offset = GetCacheBucketsOffset(s_cache_header);
+	const u64 hash = HashCachePath(path);
+	for (u32 i = 0; i < num_buckets; i++)
+	{
+		u32 bucket;
+		std::memcpy(&bucket, s_cache_data.data() + buckets_offset + ((hash + i) & (num_buckets - 1)) * sizeof(u32),
+			sizeof(bucket));
+		if (bucket == 0 || bucket > s_cache_header.num_records)
+			break;
 
-	if (!LoadEntriesFromCache(stream.get()))
+		const u64 offset = sizeof(CacheHeader) + static_cast<u64>(bucket - 1) * sizeof(CacheRecord);
+		CacheRecord rec;
+		std::string_view rec_path;
+		if (GetCacheRecordAt(offset, &rec) && rec.path_hash == hash &&
+			GetCacheString(rec.path, s_cache_header.strings_offset, s_cache_header.strings_size, &rec_path) &&
+			rec_path == path)
+		{
+			return offset;
+		}
+	}
+
+	return std::nullopt;
+}
+
+bool GameList::ReadCacheRecord(u64 offset, GameList::Entry* entry)
+{
+	CacheRecord rec;
+	if (!GetCacheRecordAt(offset, &rec) || (rec.flags & GAME_LIST_CACHE_RECORD_DELETED))
+		return false;
+
+	u64 strings_base, strings_size;
+	GetCacheRecordStrings(offset, rec, &strings_base, &strings_size);
+
+	std::string_view path, serial, title, title_sort, title_en;
+	if (!GetCacheString(rec.path, strings_base, strings_size, &path) ||
+		!GetCacheString(rec.serial, strings_base, strings_size, &serial) ||
+		!GetCacheString(rec.title, strings_base, strings_size, &title) ||
+		!GetCacheString(rec.title_sort, strings_base, strings_size, &title_sort) ||
+		!GetCacheString(rec.title_en, strings_base, strings_size, &title_en) ||
+		rec.region >= static_cast<u8>(Region::Count) || rec.type >= static_cast<u8>(EntryType::Count) ||
+		rec.compatibility_rating > static_cast<u8>(CompatibilityRating::Perfect))
 	{
-		Console.Warning("Deleting corrupted cache file '%s'", cache_filename.c_str());
-		stream.reset();
-		s_cache_map.clear();
-		DeleteCacheFile();
-		return;
+		Console.Warning("Game list cache entry is corrupted");
+		return false;
 	}
+
+	entry->path = path;
+	entry->serial = serial;
+	entry->title = title;
+	entry->title_sort = title_sort;
+	entry->title_en = title_en;
+	entry->type = static_cast<EntryType>(rec.type);
+	entry->region = static_cast<Region>(rec.region);
+	entry->compatibility_rating = static_cast<CompatibilityRating>(rec.compatibility_rating);
+	entry->total_size = rec.total_size;
+	entry->last_modified_time = static_cast<std::time_t>(rec.last_modified_time);
+	entry->crc = rec.crc;
+	return true;
 }
 
 bool GameList::OpenCacheForWriting()
@@ -587,10 +745,11 @@ bool GameList::OpenCacheForWriting()
 	if (s_cache_write_stream)
 	{
 		// check the header
-		u32 signature, version;
-		if (ReadU32(s_cache_write_stream, &signature) && signature == GAME_LIST_CACHE_SIGNATURE &&
-			ReadU32(s_cache_write_stream, &version) && version == GAME_LIST_CACHE_VERSION &&
-			FileSystem::FSeek64(s_cache_write_stream, 0, SEEK_END) == 0)
+		CacheHeader header;
+		if (std::fread(&header, sizeof(header), 1, s_cache_write_stream) == 1 &&
+			header.signature == GAME_LIST_CACHE_SIGNATURE && header.version == GAME_LIST_CACHE_VERSION &&
+			FileSystem::FSeek64(s_cache_write_stream, 0, SEEK_END) == 0 &&
+			(FileSystem::FTell64(s_cache_write_stream) % 8) == 0)
 		{
 			return true;
 		}
@@ -600,13 +759,20 @@ bool GameList::OpenCacheForWriting()
 
 	Console.WriteLn("Creating new game list cache file: '%s'", cache_filename.c_str());
 
+	// can't truncate the file underneath the mapping
+	UnloadCache();
+
 	s_cache_write_stream = FileSystem::OpenCFile(cache_filename.c_str(), "w+b");
 	if (!s_cache_write_stream)
 		return false;
 
-
-	// new cache file, write header
-	if (!WriteU32(s_cache_write_stream, GAME_LIST_CACHE_SIGNATURE) || !WriteU32(s_cache_write_stream, GAME_LIST_CACHE_VERSION))
+	// new cache file, write header for an empty table
+	CacheHeader header = {};
+	header.signature = GAME_LIST_CACHE_SIGNATURE;
+	header.version = GAME_LIST_CACHE_VERSION;
+	header.strings_offset = sizeof(CacheHeader);
+	header.appended_offset = sizeof(CacheHeader);
+	if (std::fwrite(&header, sizeof(header), 1, s_cache_write_stream) != 1)
 	{
 		Console.Error("Failed to write game list cache header");
 		std::fclose(s_cache_write_stream);
@@ -620,18 +786,15 @@ bool GameList::OpenCacheForWriting()
 
 bool GameList::WriteEntryToCache(const Entry* entry)
 {
-	bool result = true;
-	result &= WriteString(s_cache_write_stream, entry->path);
-	result &= WriteString(s_cache_write_stream, entry->serial);
-	result &= WriteString(s_cache_write_stream, entry->title);
-	result &= WriteString(s_cache_write_stream, entry->title_sort);
-	result &= WriteString(s_cache_write_stream, entry->title_en);
-	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->type));
-	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->region));
-	result &= WriteU64(s_cache_write_stream, entry->total_size);
-	result &= WriteU64(s_cache_write_stream, static_cast<u64>(entry->last_modified_time));
-	result &= WriteU32(s_cache_write_stream, entry->crc);
-	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->compatibility_rating));
+	CacheRecord rec;
+	std::string strings;
+	FillCacheRecord(*entry, &rec, &strings);
+
+	// keep the next record aligned
+	strings.resize(Common::AlignUpPow2(strings.size(), 8), '\0');
+
+	bool result = (std::fwrite(&rec, sizeof(rec), 1, s_cache_write_stream) == 1 &&
+				   std::fwrite(strings.data(), strings.size(), 1, s_cache_write_stream) == 1);
 
 	// flush after each entry, that way we don't end up with a corrupted file if we crash scanning.
 	if (result)
@@ -640,6 +803,29 @@ bool GameList::WriteEntryToCache(const Entry* entry)
 	return result;
 }
 
+void GameList::MarkCacheRecordDeleted(u64 offset)
+{
+	CacheRecord rec;
+	if (!s_cache_write_stream || !GetCacheRecordAt(offset, &rec) || (rec.flags & GAME_LIST_CACHE_RECORD_DELETED))
+		return;
+
+	const u8 flags = rec.flags | GAME_LIST_CACHE_RECORD_DELETED;
+	bool result = (FileSystem::FSeek64(s_cache_write_stream, offset + offsetof(CacheRecord, flags), SEEK_SET) == 0 &&
+				   std::fwrite(&flags, sizeof(flags), 1, s_cache_write_stream) == 1);
+
+	// appended records are counted as stale already
+	if (result && offset < s_cache_header.appended_offset)
+	{
+		s_cache_header.num_deleted_records++;
+		s_cache_stale_records++;
+		result = (FileSystem::FSeek64(s_cache_write_stream, offsetof(CacheHeader, num_deleted_records), SEEK_SET) == 0 &&
+				  std::fwrite(&s_cache_header.num_deleted_records, sizeof(u32), 1, s_cache_write_stream) == 1);
+	}
+
+	if (!result || std::fflush(s_cache_write_stream) != 0 || FileSystem::FSeek64(s_cache_write_stream, 0, SEEK_END) != 0)
+		Console.Warning("Failed to mark game list cache entry as deleted");
+}
+
 void GameList::CloseCacheFileStream()
 {
 	if (!s_cache_write_stream)
@@ -653,6 +839,8 @@ void GameList::DeleteCacheFile()
 {
 	pxAssert(!s_cache_write_stream);
 
+	UnloadCache();
+
 	const std::string cache_filename(GetCacheFilename());
 	if (cache_filename.empty() || !FileSystem::FileExists(cache_filename.c_str()))
 		return;
@@ -663,18 +851,84 @@ void GameList::DeleteCacheFile()
 		Console.Warning("Failed to delete game list cache '%s'", cache_filename.c_str());
 }
 
-void GameList::RewriteCacheFile()
+void GameList::CompactCacheFile()
 {
+	// Pick up everything which was appended while scanning.
 	CloseCacheFileStream();
-	DeleteCacheFile();
+	LoadCache();
+	if (s_cache_data.empty())
+		return;
 
-	if (OpenCacheForWriting())
+	const u32 total_records = s_cache_header.num_records + s_cache_stale_records - s_cache_header.num_deleted_records;
+	if (s_cache_stale_records == 0 ||
+		(s_cache_stale_records < GAME_LIST_CACHE_COMPACT_THRESHOLD && (s_cache_stale_records * 4) < total_records))
 	{
-		for (const GameList::Entry& entry : s_entries)
-			WriteEntryToCache(&entry);
+		UnloadCache();
+		return;
+	}
+
+	std::vector<Entry> entries;
+	entries.reserve(total_records);
+	for (u32 i = 0; i < s_cache_header.num_records; i++)
+	{
+		Entry entry;
+		if (ReadCacheRecord(sizeof(CacheHeader) + static_cast<u64>(i) * sizeof(CacheRecord), &entry) &&
+			!s_cache_appended_records.contains(entry.path))
+		{
+			entries.push_back(std::move(entry));
+		}
+	}
+	for (const auto& [path, offset] : s_cache_appended_records)
+	{
+		Entry entry;
+		if (ReadCacheRecord(offset, &entry))
+			entries.push_back(std::move(entry));
+	}
 
-		CloseCacheFileStream();
+	CacheHeader header = {};
+	header.signature = GAME_LIST_CACHE_SIGNATURE;
+	header.version = GAME_LIST_CACHE_VERSION;
+	header.num_records = static_cast<u32>(entries.size());
+	header.num_buckets = std::max<u32>(std::bit_ceil(header.num_records * 2), GAME_LIST_CACHE_MIN_BUCKETS);
+
+	std::vector<CacheRecord> records(entries.size());
+	std::vector<u32> buckets(header.num_buckets);
+	std::string strings;
+	for (u32 i = 0; i < header.num_records; i++)
+	{
+		FillCacheRecord(entries[i], &records[i], &strings);
+
+		u64 bucket = records[i].path_hash;
+		while (buckets[bucket & (header.num_buckets - 1)] != 0)
+			bucket++;
+		buckets[bucket & (header.num_buckets - 1)] = i + 1;
 	}
+
+	header.strings_offset = GetCacheBucketsOffset(header) + buckets.size() * sizeof(u32);
+	header.strings_size = strings.size();
+	header.appended_offset = Common::AlignUpPow2(header.strings_offset + header.strings_size, 8);
+
+	std::vector<u8> data(header.appended_offset);
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + sizeof(header), records.data(), records.size() * sizeof(CacheRecord));
+	std::memcpy(data.data() + GetCacheBucketsOffset(header), buckets.data(), buckets.size() * sizeof(u32));
+	std::memcpy(data.data() + header.strings_offset, strings.data(), strings.size());
+
+	// mapping has to go before we can replace the file on Windows
+	UnloadCache();
+
+	const std::string cache_filename(GetCacheFilename());
+	const std::string temp_filename(cache_filename + ".tmp");
+	Error error;
+	if (!FileSystem::WriteBinaryFile(temp_filename.c_str(), data.data(), data.size()) ||
+		!FileSystem::RenamePath(temp_filename.c_str(), cache_filename.c_str(), &error))
+	{
+		Console.Error(fmt::format("Failed to compact game list cache: {}", error.GetDescription()));
+		FileSystem::DeleteFilePath(temp_filename.c_str());
+		return;
+	}
+
+	DevCon.WriteLn(fmt::format("Compacted game list cache to {} entries", header.num_records));
 }
 
 static bool IsPathExcluded(const std::vector<std::string>& excluded_paths, const std::string& path)
@@ -706,25 +960,83 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
 	progress->SetProgressRange(static_cast<u32>(files.size()));
 	progress->SetProgressValue(0);
 
+	// Pick up everything we already know about first, the remaining files get probed in parallel.
+	std::vector<FILESYSTEM_FIND_DATA*> files_to_scan;
 	for (FILESYSTEM_FIND_DATA& ffd : files)
 	{
-		files_scanned++;
+		if (progress->IsCancelled())
+			break;
 
-		if (progress->IsCancelled() || !GameList::IsScannableFilename(ffd.FileName) || IsPathExcluded(excluded_paths, ffd.FileName))
+		if (!GameList::IsScannableFilename(ffd.FileName) || IsPathExcluded(excluded_paths, ffd.FileName))
 		{
+			files_scanned++;
 			continue;
 		}
 
 		std::unique_lock lock(s_mutex);
 		if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
 		{
+			files_scanned++;
 			continue;
 		}
 
-		const std::string_view filename = Path::GetFileName(ffd.FileName);
-		progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {}..."), filename.data()).c_str());
-		ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map, custom_attributes_ini);
-		progress->SetProgressValue(files_scanned);
+		files_to_scan.push_back(&ffd);
+	}
+
+	progress->SetProgressValue(files_scanned);
+
+	if (!files_to_scan.empty() && !progress->IsCancelled())
+	{
+		std::atomic<size_t> next_file{0};
+		std::atomic<u32> files_probed{0};
+		std::atomic_bool cancelled{false};
+
+		const auto scan_files = [&](bool is_main_thread) {
+			for (;;)
+			{
+				if (is_main_thread && progress->IsCancelled())
+					cancelled.store(true, std::memory_order_relaxed);
+				if (cancelled.load(std::memory_order_relaxed))
+					break;
+
+				const size_t index = next_file.fetch_add(1, std::memory_order_relaxed);
+				if (index >= files_to_scan.size())
+					break;
+
+				FILESYSTEM_FIND_DATA& ffd = *files_to_scan[index];
+				if (is_main_thread)
+				{
+					const std::string_view filename = Path::GetFileName(ffd.FileName);
+					progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {}..."), filename).c_str());
+				}
+
+				std::unique_lock lock(s_mutex);
+				ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map, custom_attributes_ini);
+				lock.unlock();
+
+				const u32 probed = files_probed.fetch_add(1, std::memory_order_relaxed) + 1;
+				if (is_main_thread)
+					progress->SetProgressValue(files_scanned + probed);
+			}
+		};
+
+		// Scanning is mostly waiting on the disk, so don't go overboard with threads.
+		const u32 num_threads = std::clamp<u32>(std::thread::hardware_concurrency(), 1u, MAX_SCAN_THREADS);
+		std::vector<std::thread> workers;
+		for (u32 i = 1; i < std::min<size_t>(num_threads, files_to_scan.size()); i++)
+		{
+			workers.emplace_back([&scan_files]() {
+				Threading::SetNameOfCurrentThread("Game List Scanner");
+				scan_files(false);
+			});
+		}
+
+		// Progress is only reported from this thread, the callback isn't thread safe.
+		scan_files(true);
+		for (std::thread& worker : workers)
+			worker.join();
+
+		files_scanned += files_probed.load(std::memory_order_relaxed);
 	}
 
 	progress->SetProgressValue(files_scanned);
@@ -762,12 +1074,21 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
 
 	Entry entry;
 	if (!PopulateEntryFromPath(path, &entry))
+	{
+		lock.lock();
 		return false;
+	}
 
 	entry.last_modified_time = timestamp;
 
+	// cache stream is shared with the other scanner threads
+	lock.lock();
+
 	if (s_cache_write_stream || OpenCacheForWriting())
 	{
+		if (const std::optional<u64> old_record = FindCacheRecord(entry.path); old_record.has_value())
+			MarkCacheRecordDeleted(old_record.value());
+
 		if (!WriteEntryToCache(&entry))
 			Console.Warning("Failed to write entry '%s' to cache", entry.path.c_str());
 	}
@@ -775,10 +1096,11 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
 	if (entry.type == EntryType::Invalid)
 	{
 		// don't add invalid entries to list
-		lock.lock();
 		return true;
 	}
 
+	lock.unlock();
+
 	const auto iter = played_time_map.find(entry.serial);
 	if (iter != played_time_map.end())
 	{
@@ -867,24 +1189,15 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 	if (!progress)
 		progress = ProgressCallback::NullProgressCallback;
 
-	Error cdvd_lock_error;
-	if (!cdvdLock(&cdvd_lock_error))
-	{
-		progress->DisplayError(cdvd_lock_error.GetDescription().c_str());
-		return;
-	}
-
-	ScopedGuard unlock_cdvd = &cdvdUnlock;
-
-	if (invalidate_cache)
-		DeleteCacheFile();
-	else
-		LoadCache();
-
 	// don't delete the old entries, since the frontend might still access them
 	std::vector<Entry> old_entries;
 	{
 		std::unique_lock lock(s_mutex);
+		if (invalidate_cache)
+			DeleteCacheFile();
+		else
+			LoadCache();
+
 		old_entries.swap(s_entries);
 	}
 
@@ -920,9 +1233,10 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 		}
 	}
 
-	// don't need unused cache entries
-	CloseCacheFileStream();
-	s_cache_map.clear();
+	// fold anything we appended back into the table if it's getting fragmented
+	std::unique_lock lock(s_mutex);
+	CompactCacheFile();
+	UnloadCache();
 }
 
 bool GameList::RescanPath(const std::string& path)
@@ -944,12 +1258,11 @@ bool GameList::RescanPath(const std::string& path)
 			return false;
 	}
 
-	// re-scan!
-	if (!ScanFile(path, sd.ModificationTime, lock, played_time, custom_attributes_ini))
-		return true;
-
-	// update cache.. this is far from ideal, but since everything's variable length, all we can do.
-	RewriteCacheFile();
+	// re-scan! the new record gets appended to the cache, and the old one flagged as deleted.
+	LoadCache();
+	ScanFile(path, sd.ModificationTime, lock, played_time, custom_attributes_ini);
+	CloseCacheFileStream();
+	UnloadCache();
 	return true;
 }
 
@@ -227,15 +227,46 @@ u32 AudioStream::GetBufferedFramesRelaxed() const
 	return (wpos + m_buffer_size - rpos) % m_buffer_size;
 }
 
+u32 AudioStream::GetLatencyTargetFrames() const
+{
+	// Enough to cover the longest gap between callbacks, with a couple of chunks of slack for the writer.
+	const u32 target = m_callback_frames.load(std::memory_order_relaxed) + CHUNK_SIZE * 2 + m_latency_margin.load(std::memory_order_relaxed);
+	return std::clamp(GetAlignedBufferSize(target), CHUNK_SIZE * 2, m_buffer_size / 2);
+}
+
+void AudioStream::UpdateCallbackCadence(u32 num_frames)
+{
+	const u64 now = Common::Timer::GetCurrentValue();
+	u32 frames = num_frames;
+	if (m_last_callback_time != 0)
+	{
+		// Backends don't always call back at the rate they read, so use the time between callbacks
+		// when it's longer. Anything longer than the whole buffer is a pause, not the cadence.
+		const u32 interval_frames = static_cast<u32>(
+			Common::Timer::ConvertValueToSeconds(now - m_last_callback_time) * static_cast<double>(m_sample_rate));
+		if (interval_frames < m_buffer_size)
+			frames = std::max(frames, interval_frames);
+	}
+	m_last_callback_time = now;
+
+	// Rise immediately, decay slowly, so the target doesn't drop straight after a late callback.
+	const u32 current = m_callback_frames.load(std::memory_order_relaxed);
+	const u32 updated = (frames >= current) ? frames : (current - (current - frames + 63) / 64);
+	m_callback_frames.store(updated, std::memory_order_relaxed);
+}
+
 void AudioStream::ReadFrames(SampleType* samples, u32 num_frames)
 {
+	if (m_parameters.stretch_low_latency)
+		UpdateCallbackCadence(num_frames);
+
 	const u32 available_frames = GetBufferedFramesRelaxed();
 	u32 frames_to_read = num_frames;
 	u32 silence_frames = 0;
 
 	if (m_filling)
 	{
-		u32 toFill = m_buffer_size / (IsStretchEnabled() ? 32 : 400);
+		u32 toFill = m_resampler_active.load(std::memory_order_relaxed) ? GetLatencyTargetFrames() : (m_buffer_size / (IsStretchEnabled() ? 32 : 400));
 		toFill = GetAlignedBufferSize(toFill);
 
 		if (available_frames < toFill)
@@ -435,6 +466,8 @@ void AudioStream::EmptyBuffer()
 		m_soundtouch->clear();
 		if (IsStretchEnabled())
 			m_soundtouch->setTempo(m_nominal_rate);
+		if (m_resampler_active.load(std::memory_order_relaxed))
+			ResampleReset();
 	}
 
 	m_wpos.store(m_rpos.load(std::memory_order_acquire), std::memory_order_release);
@@ -618,17 +651,41 @@ void AudioStream::StretchAllocate()
 	m_average_available = 0;
 
 	m_staging_buffer_pos = 0;
+
+	if (m_parameters.stretch_low_latency)
+	{
+		m_resample_input = std::make_unique<float[]>((RESAMPLE_HISTORY_FRAMES + CHUNK_SIZE) * m_internal_channels);
+		m_resample_output = std::make_unique<float[]>((CHUNK_SIZE * 2) * m_internal_channels);
+		m_latency_margin.store(0, std::memory_order_relaxed);
+		m_latency_margin_decay_count = 0;
+		m_resampler_active.store(CanUseResampler(), std::memory_order_relaxed);
+		ResampleReset();
+	}
 }
 
 void AudioStream::StretchDestroy()
 {
 	m_soundtouch.reset();
+	m_resample_output.reset();
+	m_resample_input.reset();
+	m_resampler_active.store(false, std::memory_order_relaxed);
 }
 
 void AudioStream::StretchWriteBlock(const float* block)
 {
 	if (IsStretchEnabled())
 	{
+		if (m_resampler_active.load(std::memory_order_relaxed))
+		{
+			if (CanUseResampler())
+			{
+				ResampleWriteBlock(block);
+				return;
+			}
+
+			SetResamplerActive(false);
+		}
+
 		m_soundtouch->putSamples(block, CHUNK_SIZE);
 
 		u32 tempProgress;
@@ -639,6 +696,20 @@ void AudioStream::StretchWriteBlock(const float* block)
 
 		if (IsStretchEnabled())
 			UpdateStretchTempo();
+
+		// Go back to the resampler once SoundTouch has been running 1:1 for a while.
+		if (m_parameters.stretch_low_latency)
+		{
+			if (m_stretch_inactive && CanUseResampler())
+			{
+				if (++m_resample_resume_count >= RESAMPLE_RESUME_COUNT)
+					SetResamplerActive(true);
+			}
+			else
+			{
+				m_resample_resume_count = 0;
+			}
+		}
 	}
 	else
 	{
@@ -760,10 +831,132 @@ void AudioStream::UpdateStretchTempo()
 		m_stretch_reset = 0;
 }
 
+bool AudioStream::CanUseResampler() const
+{
+	return IsInRange(m_nominal_rate, 1.0f - RESAMPLE_NOMINAL_RANGE, 1.0f + RESAMPLE_NOMINAL_RANGE);
+}
+
+void AudioStream::SetResamplerActive(bool active)
+{
+	LOG_UNDERRUN("{} low latency resampler.", active ? "Switching to" : "Switching away from");
+	m_resampler_active.store(active, std::memory_order_relaxed);
+	m_resample_resume_count = 0;
+
+	if (active)
+	{
+		// Whatever SoundTouch was holding onto is dropped, it's only a sequence's worth.
+		m_soundtouch->clear();
+		ResampleReset();
+	}
+	else
+	{
+		m_soundtouch->setTempo(m_nominal_rate);
+		m_stretch_reset = STRETCH_RESET_THRESHOLD;
+	}
+}
+
+void AudioStream::ResampleReset()
+{
+	std::memset(m_resample_input.get(), 0, RESAMPLE_HISTORY_FRAMES * m_internal_channels * sizeof(float));
+	m_resample_pos = 1.0f;
+	m_resample_step = m_nominal_rate;
+	m_resample_integral = 0.0f;
+	m_resample_average_fill = static_cast<float>(GetBufferedFramesRelaxed());
+	m_resample_pinned_count = 0;
+	m_resample_underruns.store(0, std::memory_order_relaxed);
+}
+
+void AudioStream::ResampleWriteBlock(const float* block)
+{
+	const u32 channels = m_internal_channels;
+	float* const input = m_resample_input.get();
+	std::memcpy(&input[RESAMPLE_HISTORY_FRAMES * channels], block, CHUNK_SIZE * channels * sizeof(float));
+
+	// Catmull-Rom between frames [pos] and [pos + 1]. The history at the start of the input holds the
+	// last frames of the previous block, so pos runs from 1 up to (but not including) CHUNK_SIZE + 1.
+	float* out = m_resample_output.get();
+	u32 out_frames = 0;
+	float pos = m_resample_pos;
+	const float step = m_resample_step;
+	while (pos < static_cast<float>(CHUNK_SIZE + 1))
+	{
+		const u32 ipos = static_cast<u32>(pos);
+		const float t = pos - static_cast<float>(ipos);
+		const float* p = &input[(ipos - 1) * channels];
+		for (u32 c = 0; c < channels; c++)
+		{
+			const float y0 = p[c];
+			const float y1 = p[channels + c];
+			const float y2 = p[channels * 2 + c];
+			const float y3 = p[channels * 3 + c];
+			const float a = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+			const float b = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+			const float d = 0.5f * (y2 - y0);
+			out[c] = ((a * t + b) * t + d) * t + y1;
+		}
+
+		out += channels;
+		out_frames++;
+		pos += step;
+	}
+
+	m_resample_pos = pos - static_cast<float>(CHUNK_SIZE);
+	std::memmove(input, &input[CHUNK_SIZE * channels], RESAMPLE_HISTORY_FRAMES * channels * sizeof(float));
+
+	InternalWriteFrames(m_resample_output.get(), out_frames);
+	ResampleUpdateRate();
+}
+
+void AudioStream::ResampleUpdateRate()
+{
+	static constexpr float FILL_SMOOTHING = 1.0f / 64.0f;
+	static constexpr float PROPORTIONAL_GAIN = 0.002f;
+	static constexpr float INTEGRAL_GAIN = 0.00001f;
+
+	// Underruns mean the backend is burstier than we've measured, so keep a bit more around. Slowly
+	// give it back if things stay stable.
+	const u32 margin = m_latency_margin.load(std::memory_order_relaxed);
+	if (m_resample_underruns.exchange(0, std::memory_order_relaxed) > 0)
+	{
+		m_latency_margin.store(std::min(margin + CHUNK_SIZE, m_buffer_size / 4), std::memory_order_relaxed);
+		m_latency_margin_decay_count = 0;
+	}
+	else if (margin > 0 && ++m_latency_margin_decay_count >= RESAMPLE_MARGIN_DECAY_COUNT)
+	{
+		m_latency_margin.store(margin - std::min(margin, CHUNK_SIZE), std::memory_order_relaxed);
+		m_latency_margin_decay_count = 0;
+	}
+
+	// The backend drains the buffer in bursts, so work from the average level.
+	const float target = static_cast<float>(GetLatencyTargetFrames());
+	const float fill = static_cast<float>(GetBufferedFramesRelaxed());
+	m_resample_average_fill += (fill - m_resample_average_fill) * FILL_SMOOTHING;
+
+	// Above target, step through the input faster (output fewer frames), and vice versa.
+	const float error = (m_resample_average_fill - target) / target;
+	m_resample_integral = std::clamp(m_resample_integral + error * INTEGRAL_GAIN, -RESAMPLE_MAX_ADJUST, RESAMPLE_MAX_ADJUST);
+	const float adjust = error * PROPORTIONAL_GAIN + m_resample_integral;
+	const float clamped_adjust = std::clamp(adjust, -RESAMPLE_MAX_ADJUST, RESAMPLE_MAX_ADJUST);
+	m_resample_step = m_nominal_rate * (1.0f + clamped_adjust);
+
+	// If we can't keep up without an audible pitch change, the speed isn't close enough to 100%,
+	// so hand over to SoundTouch.
+	if (clamped_adjust != adjust || std::abs(m_resample_integral) >= RESAMPLE_MAX_ADJUST)
+	{
+		if (++m_resample_pinned_count >= RESAMPLE_FALLBACK_COUNT)
+			SetResamplerActive(false);
+	}
+	else
+	{
+		m_resample_pinned_count = 0;
+	}
+}
+
 void AudioStream::StretchUnderrun()
 {
 	// Didn't produce enough frames in time.
 	m_stretch_reset++;
+	m_resample_underruns.fetch_add(1, std::memory_order_relaxed);
 }
 
 void AudioStream::StretchOverrun()
@@ -788,6 +981,7 @@ void AudioStreamParameters::LoadSave(SettingsWrapper& wrap, const char* section)
 	stretch_overlap_ms = static_cast<u16>(std::clamp<int>(wrap.EntryBitfield(section, "StretchOverlapMS", DEFAULT_STRETCH_OVERLAP), 0, std::numeric_limits<u16>::max()));
 	stretch_use_quickseek = wrap.EntryBitBool(section, "StretchUseQuickSeek", DEFAULT_STRETCH_USE_QUICKSEEK);
 	stretch_use_aa_filter = wrap.EntryBitBool(section, "StretchUseAAFilter", DEFAULT_STRETCH_USE_AA_FILTER);
+	stretch_low_latency = wrap.EntryBitBool(section, "StretchLowLatency", stretch_low_latency, DEFAULT_STRETCH_LOW_LATENCY);
 
 	expand_block_size = static_cast<u16>(std::clamp<int>(wrap.EntryBitfield(section, "ExpandBlockSize", DEFAULT_EXPAND_BLOCK_SIZE), 0, std::numeric_limits<u16>::max()));
 	wrap.Entry(section, "ExpandCircularWrap", expand_circular_wrap, DEFAULT_EXPAND_CIRCULAR_WRAP);
@@ -67,10 +67,14 @@ public:
 	__fi AudioExpansionMode GetExpansionMode() const { return m_parameters.expansion_mode; }
 	__fi bool IsExpansionEnabled() const { return m_parameters.expansion_mode != AudioExpansionMode::Disabled; }
 	__fi bool IsStretchEnabled() const { return m_stretch_enabled; }
+	__fi bool IsResamplerActive() const { return m_resampler_active.load(std::memory_order_relaxed); }
 	__fi bool IsPaused() const { return m_paused; }
 
 	u32 GetBufferedFramesRelaxed() const;
 
+	/// Returns the number of frames the low latency resampler is trying to keep buffered.
+	u32 GetLatencyTargetFrames() const;
+
 	/// Temporarily pauses the stream, preventing it from requesting data.
 	virtual void SetPaused(bool paused);
 
@@ -139,6 +143,13 @@ private:
 	static constexpr u32 STRETCH_RESET_THRESHOLD = 5;
 	static constexpr u32 TARGET_IPS = 691;
 
+	static constexpr u32 RESAMPLE_HISTORY_FRAMES = 3;
+	static constexpr float RESAMPLE_MAX_ADJUST = 0.005f;
+	static constexpr float RESAMPLE_NOMINAL_RANGE = 0.05f;
+	static constexpr u32 RESAMPLE_FALLBACK_COUNT = 500;
+	static constexpr u32 RESAMPLE_RESUME_COUNT = 500;
+	static constexpr u32 RESAMPLE_MARGIN_DECAY_COUNT = 4096;
+
 	static std::vector<std::pair<std::string, std::string>> GetCubebDriverNames();
 	static std::vector<DeviceInfo> GetCubebOutputDevices(const char* driver);
 	static std::unique_ptr<AudioStream> CreateCubebAudioStream(u32 sample_rate, const AudioStreamParameters& parameters,
@@ -163,6 +174,13 @@ private:
 	float AddAndGetAverageTempo(float val);
 	void UpdateStretchTempo();
 
+	bool CanUseResampler() const;
+	void SetResamplerActive(bool active);
+	void ResampleReset();
+	void ResampleWriteBlock(const float* block);
+	void ResampleUpdateRate();
+	void UpdateCallbackCadence(u32 num_frames);
+
 	u32 m_buffer_size = 0;
 	std::unique_ptr<float[]> m_buffer;
 	SampleReader m_sample_reader = nullptr;
@@ -188,6 +206,27 @@ private:
 	// temporary staging buffer, used for timestretching
 	std::unique_ptr<SampleType[]> m_staging_buffer;
 
+	// Low latency mode: while the speed is close to 100%, the buffer level is held at the target by
+	// nudging the rate of a cubic resampler, instead of going through SoundTouch. The target follows
+	// how many frames the backend asks for at once, plus a margin which grows after underruns.
+	// The flag and the margin are also read by the backend's callback, to pick the fill target.
+	std::atomic_bool m_resampler_active{false};
+	float m_resample_pos = 0.0f;
+	float m_resample_step = 1.0f;
+	float m_resample_integral = 0.0f;
+	float m_resample_average_fill = 0.0f;
+	u32 m_resample_pinned_count = 0;
+	u32 m_resample_resume_count = 0;
+	std::atomic<u32> m_latency_margin{0};
+	u32 m_latency_margin_decay_count = 0;
+	std::atomic<u32> m_resample_underruns{0};
+	std::unique_ptr<float[]> m_resample_input;
+	std::unique_ptr<float[]> m_resample_output;
+
+	// Updated by the backend's callback, the longest recent gap between callbacks in frames.
+	std::atomic<u32> m_callback_frames{0};
+	u64 m_last_callback_time = 0;
+
 	std::unique_ptr<FreeSurroundDecoder> m_expander;
 
 	// block buffer for expansion
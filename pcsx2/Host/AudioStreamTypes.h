@@ -40,6 +40,7 @@ struct AudioStreamParameters
 	u16 stretch_overlap_ms = DEFAULT_STRETCH_OVERLAP;
 	bool stretch_use_quickseek = DEFAULT_STRETCH_USE_QUICKSEEK;
 	bool stretch_use_aa_filter = DEFAULT_STRETCH_USE_AA_FILTER;
+	bool stretch_low_latency = DEFAULT_STRETCH_LOW_LATENCY;
 
 	float expand_circular_wrap = DEFAULT_EXPAND_CIRCULAR_WRAP;
 	float expand_shift = DEFAULT_EXPAND_SHIFT;
@@ -74,6 +75,7 @@ struct AudioStreamParameters
 
 	static constexpr bool DEFAULT_STRETCH_USE_QUICKSEEK = false;
 	static constexpr bool DEFAULT_STRETCH_USE_AA_FILTER = false;
+	static constexpr bool DEFAULT_STRETCH_LOW_LATENCY = false;
 
 	void LoadSave(SettingsWrapper& wrap, const char* section);
 
@@ -2,12 +2,14 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Achievements.h"
+#include "DebugTools/GuestProfiler.h"
 #include "GS.h"
 #include "Host.h"
 #include "IconsFontAwesome.h"
 #include "ImGui/FullscreenUI.h"
 #include "ImGui/ImGuiOverlays.h"
 #include "Input/InputManager.h"
+#include "PerformanceMetrics.h"
 #include "Recording/InputRecording.h"
 #include "SPU2/spu2.h"
 #include "VMManager.h"
@@ -257,6 +259,80 @@ DEFINE_HOTKEY("SwapMemCards", TRANSLATE_NOOP("Hotkeys", "System"),
 				FileMcd_Swap();
 			});
 	})
+DEFINE_HOTKEY("ToggleGuestProfiler", TRANSLATE_NOOP("Hotkeys", "System"),
+	TRANSLATE_NOOP("Hotkeys", "Toggle Guest Profiler"), [](s32 pressed) {
+		if (!pressed && VMManager::HasValidVM())
+		{
+			Host::RunOnCPUThread([]() {
+				Error error;
+				if (GuestProfiler::IsActive())
+				{
+					if (GuestProfiler::Stop(&error))
+					{
+						Host::AddIconOSDMessage("GuestProfiler", ICON_FA_STOPWATCH,
+							fmt::format(TRANSLATE_FS("Hotkeys", "Guest profile saved to '{}'."),
+								Path::GetFileName(GuestProfiler::GetOutputPath())),
+							Host::OSD_INFO_DURATION);
+					}
+					else
+					{
+						Host::AddIconOSDMessage("GuestProfiler", ICON_FA_TRIANGLE_EXCLAMATION,
+							fmt::format(TRANSLATE_FS("Hotkeys", "Failed to save guest profile: {}"), error.GetDescription()),
+							Host::OSD_ERROR_DURATION);
+					}
+					return;
+				}
+
+				const std::string serial = VMManager::GetDiscSerial();
+				std::string path = Path::Combine(EmuFolders::Logs,
+					fmt::format("profile_{}_{}.folded", serial.empty() ? "unknown" : serial, std::time(nullptr)));
+				if (GuestProfiler::Start(std::move(path), GuestProfiler::DEFAULT_SAMPLE_INTERVAL_US, &error))
+				{
+					Host::AddIconOSDMessage("GuestProfiler", ICON_FA_STOPWATCH,
+						TRANSLATE_STR("Hotkeys", "Guest profiler started."), Host::OSD_QUICK_DURATION);
+				}
+				else
+				{
+					Host::AddIconOSDMessage("GuestProfiler", ICON_FA_TRIANGLE_EXCLAMATION,
+						fmt::format(TRANSLATE_FS("Hotkeys", "Failed to start guest profiler: {}"), error.GetDescription()),
+						Host::OSD_ERROR_DURATION);
+				}
+			});
+		}
+	})
+DEFINE_HOTKEY("ToggleRingStatsDump", TRANSLATE_NOOP("Hotkeys", "System"),
+	TRANSLATE_NOOP("Hotkeys", "Toggle Thread Ring Statistics Dump"), [](s32 pressed) {
+		if (!pressed && VMManager::HasValidVM())
+		{
+			Host::RunOnCPUThread([]() {
+				if (PerformanceMetrics::IsDumpingRingStats())
+				{
+					PerformanceMetrics::StopRingStatsDump();
+					Host::AddIconOSDMessage("RingStatsDump", ICON_FA_STOPWATCH,
+						fmt::format(TRANSLATE_FS("Hotkeys", "Thread ring statistics saved to '{}'."),
+							Path::GetFileName(PerformanceMetrics::GetRingStatsDumpPath())),
+						Host::OSD_INFO_DURATION);
+					return;
+				}
+
+				Error error;
+				const std::string serial = VMManager::GetDiscSerial();
+				std::string path = Path::Combine(EmuFolders::Logs,
+					fmt::format("rings_{}_{}.csv", serial.empty() ? "unknown" : serial, std::time(nullptr)));
+				if (PerformanceMetrics::StartRingStatsDump(std::move(path), &error))
+				{
+					Host::AddIconOSDMessage("RingStatsDump", ICON_FA_STOPWATCH,
+						TRANSLATE_STR("Hotkeys", "Thread ring statistics dump started."), Host::OSD_QUICK_DURATION);
+				}
+				else
+				{
+					Host::AddIconOSDMessage("RingStatsDump", ICON_FA_TRIANGLE_EXCLAMATION,
+						fmt::format(TRANSLATE_FS("Hotkeys", "Failed to start thread ring statistics dump: {}"), error.GetDescription()),
+						Host::OSD_ERROR_DURATION);
+				}
+			});
+		}
+	})
 DEFINE_HOTKEY("InputRecToggleMode", TRANSLATE_NOOP("Hotkeys", "System"),
 	TRANSLATE_NOOP("Hotkeys", "Toggle Input Recording Mode"), [](s32 pressed) {
 		if (!pressed && VMManager::HasValidVM())
@@ -10,6 +10,10 @@
 #include <limits.h>
 #include "Config.h"
 
+#include "common/Threading.h"
+
+#include <atomic>
+
 // the BP doesn't advance and returns -1 if there is no data to be read
 alignas(16) tIPU_cmd ipu_cmd;
 alignas(16) tIPU_BP g_BP;
@@ -18,6 +22,30 @@ IPUStatus IPUCoreStatus;
 
 static void (*IPUWorker)();
 
+// How often the EE checks whether the IPU thread is done, when nothing else needs it to be.
+static constexpr s32 IPU_THREAD_POLL_CYCLES = 256;
+
+static Threading::Thread s_ipu_thread;
+static Threading::WorkSema s_ipu_sema;
+static std::atomic_bool s_ipu_thread_shutdown{false};
+static std::atomic_bool s_ipu_thread_done{true};
+
+// Set while the IPU thread owns the IPU state. The EE doesn't touch any of it until ipuThreadSync().
+static bool s_ipu_thread_busy = false;
+
+// IPU0 DMA state when the work was handed over, the EE may be changing the registers meanwhile.
+static bool s_ipu_thread_from_dma_ready = false;
+
+// Things the IPU would have done to EE state while running on the thread, done when the EE syncs.
+static struct
+{
+	bool input_requested;
+	bool output_written;
+	bool process_requested;
+	bool irq;
+	u32 process_cycles;
+} s_ipu_thread_deferred;
+
 // Color conversion stuff, the memory layout is a total hack
 // convert_data_buffer is a pointer to the internal rgb struct (the first param in convert_init_t)
 //char convert_data_buffer[sizeof(convert_rgb_t)];
@@ -78,10 +106,145 @@ void tIPU_cmd::clear()
 	current = 0xffffffff;
 }
 
+static void ipuThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("IPU");
+
+	for (;;)
+	{
+		s_ipu_sema.WaitForWork();
+		if (s_ipu_thread_shutdown.load(std::memory_order_acquire))
+			break;
+
+		IPUWorker();
+		s_ipu_thread_done.store(true, std::memory_order_release);
+	}
+
+	s_ipu_sema.Kill();
+}
+
+// Runs the current command until it needs more input, or has filled the output FIFO. The macroblock
+// decoding and colour conversion commands go to the IPU thread when the speedhack is enabled.
+static void ipuDispatchWorker()
+{
+	// We need the process event to come back for the results.
+	const bool threaded = EmuConfig.Speedhacks.ipuThread && !(cpuRegs.interrupt & (1 << IPU_PROCESS)) &&
+		(ipu_cmd.CMD == SCE_IPU_IDEC || ipu_cmd.CMD == SCE_IPU_BDEC || ipu_cmd.CMD == SCE_IPU_CSC || ipu_cmd.CMD == SCE_IPU_PACK);
+	if (!threaded)
+	{
+		IPUWorker();
+		return;
+	}
+
+	if (!s_ipu_thread.Joinable())
+	{
+		s_ipu_sema.Reset();
+		s_ipu_thread_shutdown.store(false, std::memory_order_release);
+		s_ipu_thread.Start(&ipuThreadEntryPoint);
+	}
+
+	s_ipu_thread_from_dma_ready = ipu0ch.chcr.STR && ipu0ch.qwc != 0;
+	s_ipu_thread_deferred = {};
+	s_ipu_thread_busy = true;
+	s_ipu_thread_done.store(false, std::memory_order_release);
+	s_ipu_sema.NotifyOfWork();
+
+	CPU_INT(IPU_PROCESS, IPU_THREAD_POLL_CYCLES);
+}
+
+void ipuThreadSync()
+{
+	if (!s_ipu_thread_busy)
+		return;
+
+	s_ipu_sema.WaitForEmpty();
+	s_ipu_thread_busy = false;
+
+	// Don't need to check back any more.
+	cpuClearInt(IPU_PROCESS);
+
+	if (s_ipu_thread_deferred.input_requested && ipu1ch.chcr.STR && cpuRegs.eCycle[4] == 0x9999)
+		CPU_INT(DMAC_TO_IPU, std::min(8U, ipu1ch.qwc));
+
+	if (s_ipu_thread_deferred.output_written && ipu0ch.chcr.STR)
+		IPU_INT_FROM(1);
+
+	if (s_ipu_thread_deferred.process_requested)
+		IPU_INT_PROCESS(s_ipu_thread_deferred.process_cycles);
+
+	if (s_ipu_thread_deferred.irq)
+		hwIntcIrq(INTC_IPU);
+}
+
+void ipuThreadShutdown()
+{
+	if (!s_ipu_thread.Joinable())
+		return;
+
+	ipuThreadSync();
+	s_ipu_thread_shutdown.store(true, std::memory_order_release);
+	s_ipu_sema.NotifyOfWork();
+	s_ipu_thread.Join();
+}
+
+bool ipuFromDmaReady()
+{
+	return s_ipu_thread_busy ? s_ipu_thread_from_dma_ready : (ipu0ch.chcr.STR && ipu0ch.qwc != 0);
+}
+
+void ipuRequestInput()
+{
+	IPUCoreStatus.DataRequested = true;
+
+	if (s_ipu_thread_busy)
+		s_ipu_thread_deferred.input_requested = true;
+	else if (ipu1ch.chcr.STR && cpuRegs.eCycle[4] == 0x9999)
+		CPU_INT(DMAC_TO_IPU, std::min(8U, ipu1ch.qwc));
+}
+
+void ipuNotifyOutput()
+{
+	if (s_ipu_thread_busy)
+		s_ipu_thread_deferred.output_written = true;
+	else if (ipu0ch.chcr.STR)
+		IPU_INT_FROM(1);
+}
+
+void ipuScheduleProcess(u32 cycles)
+{
+	if (s_ipu_thread_busy)
+	{
+		s_ipu_thread_deferred.process_requested = true;
+		s_ipu_thread_deferred.process_cycles = cycles;
+		return;
+	}
+
+	IPU_INT_PROCESS(cycles);
+}
+
+void ipuCommandFinished()
+{
+	if (s_ipu_thread_busy)
+		s_ipu_thread_deferred.irq = true;
+	else
+		hwIntcIrq(INTC_IPU);
+}
+
 __fi void IPUProcessInterrupt()
 {
+	if (s_ipu_thread_busy)
+	{
+		// Don't hold the EE up if the thread is still going, anything which needs the results will sync.
+		if (!s_ipu_thread_done.load(std::memory_order_acquire))
+			CPU_INT(IPU_PROCESS, IPU_THREAD_POLL_CYCLES);
+		else
+			ipuThreadSync();
+
+		return;
+	}
+
 	if (ipuRegs.ctrl.BUSY)
-		IPUWorker();
+		ipuDispatchWorker();
 }
 
 /////////////////////////////////////////////////////////
@@ -89,6 +252,14 @@ __fi void IPUProcessInterrupt()
 
 void ipuReset()
 {
+	// Whatever the thread was doing is thrown away with the rest of the state.
+	if (s_ipu_thread_busy)
+	{
+		s_ipu_sema.WaitForEmpty();
+		s_ipu_thread_busy = false;
+		cpuClearInt(IPU_PROCESS);
+	}
+
 	IPUWorker = MULTI_ISA_SELECT(IPUWorker);
 	std::memset(&ipuRegs, 0, sizeof(ipuRegs));
 	std::memset(&g_BP, 0, sizeof(g_BP));
@@ -221,6 +392,8 @@ __fi u32 ipuRead32(u32 mem)
 	pxAssert((mem & ~0xff) == 0x10002000);
 	mem &= 0xff;	// ipu repeats every 0x100
 
+	ipuThreadSync();
+
 	switch (mem)
 	{
 		ipucase(IPU_CMD) : // IPU_CMD
@@ -271,6 +444,8 @@ __fi u64 ipuRead64(u32 mem)
 	pxAssert((mem & ~0xff) == 0x10002000);
 	mem &= 0xff;	// ipu repeats every 0x100
 
+	ipuThreadSync();
+
 	switch (mem)
 	{
 		ipucase(IPU_CMD): // IPU_CMD
@@ -338,6 +513,8 @@ __fi bool ipuWrite32(u32 mem, u32 value)
 	pxAssert((mem & ~0xfff) == 0x10002000);
 	mem &= 0xfff;
 
+	ipuThreadSync();
+
 	switch (mem)
 	{
 		ipucase(IPU_CMD): // IPU_CMD
@@ -373,6 +550,8 @@ __fi bool ipuWrite64(u32 mem, u64 value)
 	pxAssert((mem & ~0xfff) == 0x10002000);
 	mem &= 0xfff;
 
+	ipuThreadSync();
+
 	switch (mem)
 	{
 		ipucase(IPU_CMD):
@@ -536,5 +715,5 @@ __fi void IPUCMD_WRITE(u32 val)
 		IPU_INT_PROCESS(64);
 	}
 	else
-		IPUWorker();
+		ipuDispatchWorker();
 }
@@ -297,3 +297,16 @@ extern void IPUCMD_WRITE(u32 val);
 extern void ipuSoftReset();
 extern void IPUProcessInterrupt();
 
+// Threaded IPU speedhack: while a command is being processed on the IPU thread, the EE carries on,
+// and only waits for it when it next touches the IPU (registers, FIFOs, DMA). Anything the command
+// does to EE state (scheduling DMA/IPU events, raising the interrupt) is queued up until then.
+extern void ipuThreadSync();
+extern void ipuThreadShutdown();
+
+// Used by the command processing, rather than touching EE state directly.
+extern bool ipuFromDmaReady();
+extern void ipuRequestInput();
+extern void ipuNotifyOutput();
+extern void ipuScheduleProcess(u32 cycles);
+extern void ipuCommandFinished();
+
@@ -89,12 +89,7 @@ int IPU_Fifo_Input::read(void *value)
 	if (g_BP.IFC <= 1)
 	{
 		// IPU FIFO is empty and DMA is waiting so lets tell the DMA we are ready to put data in the FIFO
-		IPUCoreStatus.DataRequested = true;
-
-		if(ipu1ch.chcr.STR && cpuRegs.eCycle[4] == 0x9999)
-		{
-			CPU_INT( DMAC_TO_IPU, std::min(8U, ipu1ch.qwc));
-		}
+		ipuRequestInput();
 
 		if (g_BP.IFC == 0) return 0;
 		pxAssert(g_BP.IFC > 0);
@@ -126,8 +121,7 @@ int IPU_Fifo_Output::write(const u32 *value, uint size)
 
 	ipuRegs.ctrl.OFC += transfer_size;
 
-	if(ipu0ch.chcr.STR)
-		IPU_INT_FROM(1);
+	ipuNotifyOutput();
 
 	return transfer_size;
 }
@@ -154,6 +148,8 @@ void IPU_Fifo_Output::read(void *value, uint size)
 
 void ReadFIFO_IPUout(mem128_t* out)
 {
+	ipuThreadSync();
+
 	pxAssertMsg(ipuRegs.ctrl.OFC > 0, "Attempted read from IPUout's FIFO, but the FIFO is empty!");
 	if (ipuRegs.ctrl.OFC == 0) [[unlikely]]
 		return;
@@ -167,6 +163,8 @@ void WriteFIFO_IPUin(const mem128_t* value)
 {
 	IPU_LOG( "WriteFIFO/IPUin <- 0x%08X.%08X.%08X.%08X", value->_u32[0], value->_u32[1], value->_u32[2], value->_u32[3]);
 
+	ipuThreadSync();
+
 	//committing every 16 bytes
 	if( ipu_fifo.in.write(value->_u32, 1) > 0 )
 	{
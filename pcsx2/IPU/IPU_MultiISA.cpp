@@ -13,20 +13,13 @@
 #include "IPU/IPUdma.h"
 #include "IPU/yuv2rgb.h"
 #include "IPU/IPU_MultiISA.h"
+#include "GS/GSVector.h"
 
 // the IPU is fixed to 16 byte strides (128-bit / QWC resolution):
 static const uint decoder_stride = 16;
 
 #if MULTI_ISA_COMPILE_ONCE
 
-static constexpr std::array<u8, 1024> make_clip_lut()
-{
-	std::array<u8, 1024> lut = {};
-	for (int i = -384; i < 640; i++)
-		lut[i+384] = (i < 0) ? 0 : ((i > 255) ? 255 : i);
-	return lut;
-}
-
 static constexpr mpeg2_scan_pack make_scan_pack()
 {
 	constexpr u8 mpeg2_scan_norm[64] = {
@@ -57,14 +50,12 @@ static constexpr mpeg2_scan_pack make_scan_pack()
 	return pack;
 }
 
-alignas(16) const std::array<u8, 1024> g_idct_clip_lut = make_clip_lut();
 alignas(16) const mpeg2_scan_pack mpeg2_scan = make_scan_pack();
 
 #endif
 
 MULTI_ISA_UNSHARED_START
 
-static void ipu_csc(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn);
 static void ipu_vq(macroblock_rgb16& rgb16, u8* indx4);
 
 // --------------------------------------------------------------------------------------
@@ -213,7 +204,8 @@ __fi static void BUTTERFLY(int& t0, int& t1, int w0, int w1, int d0, int d1)
 	t1 = tmp - (w1 + w0) * d0;
 }
 
-__ri static void IDCT_Block(s16* block)
+// conforming implementation for reference, do not optimise
+void IDCT_Block_reference(s16* block)
 {
 	for (int i = 0; i < 8; i++)
 	{
@@ -322,25 +314,171 @@ __ri static void IDCT_Block(s16* block)
 	}
 }
 
-__ri static void IDCT_Copy(s16* block, u8* dest, const int stride)
+// The widest integer vector we have. With AVX2, an IDCT pass does all 8 rows or columns at once.
+#if _M_SSE >= 0x501
+using IPUVector = GSVector8i;
+#else
+using IPUVector = GSVector4i;
+#endif
+
+// The vector IDCT does the same 32-bit arithmetic as the reference, but on one row (or column)
+// per lane, so it needs no special case for DC-only rows.
+template <bool column>
+__fi static void IDCT_Pass(IPUVector* v)
 {
-	IDCT_Block(block);
+	IPUVector a0, a1, a2, a3;
+	{
+		const IPUVector d0 = v[0].sll32<11>().add32(IPUVector(column ? 65536 : 128));
+		const IPUVector d2 = v[2].sll32<11>();
+		const IPUVector t0 = d0.add32(d2);
+		const IPUVector t1 = d0.sub32(d2);
+		const IPUVector tmp = IPUVector(W6).mul32l(v[3].add32(v[1]));
+		const IPUVector t2 = tmp.add32(IPUVector(W2 - W6).mul32l(v[1]));
+		const IPUVector t3 = tmp.sub32(IPUVector(W2 + W6).mul32l(v[3]));
+		a0 = t0.add32(t2);
+		a1 = t1.add32(t3);
+		a2 = t1.sub32(t3);
+		a3 = t0.sub32(t2);
+	}
 
+	IPUVector b0, b1, b2, b3;
+	{
+		const IPUVector tmp0 = IPUVector(W7).mul32l(v[7].add32(v[4]));
+		const IPUVector t0 = tmp0.add32(IPUVector(W1 - W7).mul32l(v[4]));
+		const IPUVector t1 = tmp0.sub32(IPUVector(W1 + W7).mul32l(v[7]));
+		const IPUVector tmp1 = IPUVector(W3).mul32l(v[5].add32(v[6]));
+		const IPUVector t2 = tmp1.add32(IPUVector(W5 - W3).mul32l(v[6]));
+		const IPUVector t3 = tmp1.sub32(IPUVector(W5 + W3).mul32l(v[5]));
+		b0 = t0.add32(t2);
+		b3 = t1.add32(t3);
+		if (column)
+		{
+			const IPUVector s0 = t0.sub32(t2).sra32<8>();
+			const IPUVector s1 = t1.sub32(t3).sra32<8>();
+			b1 = s0.add32(s1).mul32l(IPUVector(181));
+			b2 = s0.sub32(s1).mul32l(IPUVector(181));
+		}
+		else
+		{
+			const IPUVector s0 = t0.sub32(t2);
+			const IPUVector s1 = t1.sub32(t3);
+			b1 = s0.add32(s1).mul32l(IPUVector(181)).sra32<8>();
+			b2 = s0.sub32(s1).mul32l(IPUVector(181)).sra32<8>();
+		}
+	}
+
+	constexpr int shift = column ? 17 : 8;
+	v[0] = a0.add32(b0).sra32<shift>();
+	v[1] = a1.add32(b1).sra32<shift>();
+	v[2] = a2.add32(b2).sra32<shift>();
+	v[3] = a3.add32(b3).sra32<shift>();
+	v[4] = a3.sub32(b3).sra32<shift>();
+	v[5] = a2.sub32(b2).sra32<shift>();
+	v[6] = a1.sub32(b1).sra32<shift>();
+	v[7] = a0.sub32(b0).sra32<shift>();
+}
+
+// Packs to 16 bits, wrapping rather than saturating like the stores in the reference do.
+__fi static GSVector4i IDCT_Pack(const GSVector4i& lo, const GSVector4i& hi)
+{
+	return lo.sll32<16>().sra32<16>().ps32(hi.sll32<16>().sra32<16>());
+}
+
+// Runs one pass over 8 vectors of 8 s16 lanes.
+template <bool column>
+__fi static void IDCT_Pass16(GSVector4i* v)
+{
+#if _M_SSE >= 0x501
+	GSVector8i d[8];
+	for (int i = 0; i < 8; i++)
+		d[i] = GSVector8i::i16to32(v[i]);
+
+	IDCT_Pass<column>(d);
+
+	for (int i = 0; i < 8; i++)
+		v[i] = IDCT_Pack(d[i].extract<0>(), d[i].extract<1>());
+#else
+	GSVector4i lo[8], hi[8];
 	for (int i = 0; i < 8; i++)
 	{
-		dest[0] = (g_idct_clip_lut.data() + 384)[block[0]];
-		dest[1] = (g_idct_clip_lut.data() + 384)[block[1]];
-		dest[2] = (g_idct_clip_lut.data() + 384)[block[2]];
-		dest[3] = (g_idct_clip_lut.data() + 384)[block[3]];
-		dest[4] = (g_idct_clip_lut.data() + 384)[block[4]];
-		dest[5] = (g_idct_clip_lut.data() + 384)[block[5]];
-		dest[6] = (g_idct_clip_lut.data() + 384)[block[6]];
-		dest[7] = (g_idct_clip_lut.data() + 384)[block[7]];
+		lo[i] = v[i].i16to32();
+		hi[i] = v[i].uph64().i16to32();
+	}
 
-		std::memset(block, 0, 16);
+	IDCT_Pass<column>(lo);
+	IDCT_Pass<column>(hi);
+
+	for (int i = 0; i < 8; i++)
+		v[i] = IDCT_Pack(lo[i], hi[i]);
+#endif
+}
 
+__fi static void IDCT_Transpose(GSVector4i* v)
+{
+	const GSVector4i a0 = v[0].upl16(v[1]);
+	const GSVector4i a1 = v[2].upl16(v[3]);
+	const GSVector4i a2 = v[4].upl16(v[5]);
+	const GSVector4i a3 = v[6].upl16(v[7]);
+	const GSVector4i a4 = v[0].uph16(v[1]);
+	const GSVector4i a5 = v[2].uph16(v[3]);
+	const GSVector4i a6 = v[4].uph16(v[5]);
+	const GSVector4i a7 = v[6].uph16(v[7]);
+
+	const GSVector4i b0 = a0.upl32(a1);
+	const GSVector4i b1 = a2.upl32(a3);
+	const GSVector4i b2 = a0.uph32(a1);
+	const GSVector4i b3 = a2.uph32(a3);
+	const GSVector4i b4 = a4.upl32(a5);
+	const GSVector4i b5 = a6.upl32(a7);
+	const GSVector4i b6 = a4.uph32(a5);
+	const GSVector4i b7 = a6.uph32(a7);
+
+	v[0] = b0.upl64(b1);
+	v[1] = b0.uph64(b1);
+	v[2] = b2.upl64(b3);
+	v[3] = b2.uph64(b3);
+	v[4] = b4.upl64(b5);
+	v[5] = b4.uph64(b5);
+	v[6] = b6.upl64(b7);
+	v[7] = b6.uph64(b7);
+}
+
+// Transforms the 8 rows of a block in place, and clears the block for the next one.
+__fi static void IDCT_Rows(s16* block, GSVector4i* rows)
+{
+	const GSVector4i zero = GSVector4i::zero();
+	for (int i = 0; i < 8; i++)
+	{
+		rows[i] = GSVector4i::load<true>(block + 8 * i);
+		GSVector4i::store<true>(block + 8 * i, zero);
+	}
+
+	// Rows first, with a row per lane, then columns.
+	IDCT_Transpose(rows);
+	IDCT_Pass16<false>(rows);
+	IDCT_Transpose(rows);
+	IDCT_Pass16<true>(rows);
+}
+
+void IDCT_Block(s16* block)
+{
+	alignas(16) GSVector4i rows[8];
+	IDCT_Rows(block, rows);
+
+	for (int i = 0; i < 8; i++)
+		GSVector4i::store<true>(block + 8 * i, rows[i]);
+}
+
+__ri static void IDCT_Copy(s16* block, u8* dest, const int stride)
+{
+	alignas(16) GSVector4i rows[8];
+	IDCT_Rows(block, rows);
+
+	// Saturating is all the clipping needed, as legal streams stay within -384..+384.
+	for (int i = 0; i < 8; i++)
+	{
+		GSVector4i::storel(dest, rows[i].pu16());
 		dest += stride;
-		block += 8;
 	}
 }
 
@@ -352,16 +490,13 @@ __ri static void IDCT_Add(const int last, s16* block, s16* dest, const int strid
 
 	if (last != 129 || (block[0] & 7) == 4)
 	{
-		IDCT_Block(block);
+		alignas(16) GSVector4i rows[8];
+		IDCT_Rows(block, rows);
 
-		const r128 zero = r128_zero();
 		for (int i = 0; i < 8; i++)
 		{
-			r128_store(dest, r128_load(block));
-			r128_store(block, zero);
-
+			GSVector4i::store<true>(dest, rows[i]);
 			dest += stride;
-			block += 8;
 		}
 	}
 	else
@@ -985,7 +1120,7 @@ __ri static bool mpeg2sliceIDEC()
 		while (1)
 		{
 			// IPU0 isn't ready for data, so let's wait for it to be
-			if ((!ipu0ch.chcr.STR || ipuRegs.ctrl.OFC || ipu0ch.qwc == 0) && ipu_cmd.pos[1] <= 2)
+			if ((!ipuFromDmaReady() || ipuRegs.ctrl.OFC) && ipu_cmd.pos[1] <= 2)
 			{
 				IPUCoreStatus.WaitingOnIPUFrom = true;
 				return false;
@@ -1103,7 +1238,7 @@ __ri static bool mpeg2sliceIDEC()
 					ready_to_decode = false;
 					IPUCoreStatus.WaitingOnIPUFrom = false;
 					IPUCoreStatus.WaitingOnIPUTo = false;
-					IPU_INT_PROCESS( 64); // Should probably be much higher, but myst 3 doesn't like it right now.
+					ipuScheduleProcess(64); // Should probably be much higher, but myst 3 doesn't like it right now.
 					ipu_cmd.pos[1] = 2;
 					return false;
 				}
@@ -1288,7 +1423,7 @@ __fi static bool mpeg2_slice()
 		ipu_cmd.pos[0] = 2;
 
 		// IPU0 isn't ready for data, so let's wait for it to be
-		if ((!ipu0ch.chcr.STR || ipuRegs.ctrl.OFC || ipu0ch.qwc == 0) && ipu_cmd.pos[0] <= 3)
+		if ((!ipuFromDmaReady() || ipuRegs.ctrl.OFC) && ipu_cmd.pos[0] <= 3)
 		{
 			IPUCoreStatus.WaitingOnIPUFrom = true;
 			return false;
@@ -1518,7 +1653,7 @@ __fi static bool mpeg2_slice()
 			ready_to_decode = false;
 			IPUCoreStatus.WaitingOnIPUFrom = false;
 			IPUCoreStatus.WaitingOnIPUTo = false;
-			IPU_INT_PROCESS( 64); // Should probably be much higher, but myst 3 doesn't like it right now.
+			ipuScheduleProcess(64); // Should probably be much higher, but myst 3 doesn't like it right now.
 			return false;
 		}
 
@@ -1875,12 +2010,13 @@ __ri static bool ipuPACK(tIPU_CMD_CSC csc)
 //  CORE Functions (referenced from MPEG library)
 // --------------------------------------------------------------------------------------
 
-__fi static void ipu_csc(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn)
+// conforming implementation for reference, do not optimise
+void ipu_csc_reference(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn)
 {
 	int i;
 	u8* p = (u8*)&rgb32;
 
-	yuv2rgb();
+	yuv2rgb_reference();
 
 	if (g_ipu_thresh[0] > 0)
 	{
@@ -1902,6 +2038,7 @@ __fi static void ipu_csc(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn)
 	}
 	if (sgn)
 	{
+		p = (u8*)&rgb32;
 		for (i = 0; i < 16*16; i++, p += 4)
 		{
 			*(u32*)p ^= 0x808080;
@@ -1909,6 +2046,46 @@ __fi static void ipu_csc(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn)
 	}
 }
 
+// Returns all ones for the pixels where R, G and B are all below the threshold.
+__fi static IPUVector ipu_csc_below(const IPUVector& rgba, u16 thresh)
+{
+	if (thresh == 0)
+		return IPUVector::zero();
+
+	// A channel is below the threshold when subtracting (threshold - 1) saturates to zero.
+	// Thresholds are 9 bits, anything over 255 is above every channel.
+	const IPUVector limit(0x01010101 * (std::min<int>(thresh, 256) - 1));
+	const IPUVector alpha(0xff000000);
+	return (rgba.subus8(limit).eq8(IPUVector::zero()) | alpha).eq32(IPUVector(-1));
+}
+
+void ipu_csc(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn)
+{
+	yuv2rgb();
+
+	const u16 thresh0 = g_ipu_thresh[0];
+	const u16 thresh1 = g_ipu_thresh[1];
+	if (thresh0 == 0 && thresh1 == 0 && !sgn)
+		return;
+
+	const IPUVector alpha_mask(0xff000000);
+	const IPUVector alpha_40(0x40000000);
+	const IPUVector sign(sgn ? 0x808080 : 0);
+
+	u8* p = reinterpret_cast<u8*>(&rgb32);
+	for (uint i = 0; i < sizeof(rgb32); i += sizeof(IPUVector))
+	{
+		IPUVector rgba = IPUVector::load<false>(p + i);
+
+		// Below the first threshold, the pixel is cleared, otherwise below the second it's made translucent.
+		const IPUVector clear = ipu_csc_below(rgba, thresh0);
+		const IPUVector translucent = ipu_csc_below(rgba, thresh1).andnot(clear) & alpha_mask;
+		rgba = rgba.andnot(clear | translucent) | (translucent & alpha_40);
+
+		IPUVector::store<false>(p + i, rgba ^ sign);
+	}
+}
+
 __fi static void ipu_vq(macroblock_rgb16& rgb16, u8* indx4)
 {
 	const auto closest_index = [&](int i, int j) {
@@ -2002,7 +2179,7 @@ __noinline void IPUWorker()
 	IPU_LOG("IPU Command finished");
 	ipuRegs.ctrl.BUSY = 0;
 	//ipu_cmd.current = 0xffffffff;
-	hwIntcIrq(INTC_IPU);
+	ipuCommandFinished();
 }
 
 MULTI_ISA_UNSHARED_END
@@ -142,6 +142,11 @@ alignas(16) extern decoder_t decoder;
 alignas(16) extern tIPU_BP g_BP;
 
 MULTI_ISA_DEF(
+	extern void IDCT_Block_reference(s16* block);
+	extern void IDCT_Block(s16* block);
+	extern void ipu_csc_reference(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn);
+	extern void ipu_csc(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn);
+	extern void ipu_dither_reference(const macroblock_rgb32& rgb32, macroblock_rgb16& rgb16, int dte);
 	extern void ipu_dither(const macroblock_rgb32& rgb32, macroblock_rgb16& rgb16, int dte);
 
 	void IPUWorker();
@@ -161,5 +166,4 @@ struct mpeg2_scan_pack
 	u8 alt[64];
 };
 
-alignas(16) extern const std::array<u8, 1024> g_idct_clip_lut;
 alignas(16) extern const mpeg2_scan_pack mpeg2_scan;
@@ -7,24 +7,10 @@
 #include "IPU/IPUdma.h"
 #include "IPU/yuv2rgb.h"
 #include "IPU/IPU_MultiISA.h"
+#include "GS/GSVector.h"
 
 MULTI_ISA_UNSHARED_START
 
-void ipu_dither_reference(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte);
-
-#if defined(_M_X86)
-void ipu_dither_sse2(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte);
-#endif
-
-__ri void ipu_dither(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte)
-{
-#if defined(_M_X86)
-    ipu_dither_sse2(rgb32, rgb16, dte);
-#else
-    ipu_dither_reference(rgb32, rgb16, dte);
-#endif
-}
-
 __ri void ipu_dither_reference(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte)
 {
     if (dte) {
@@ -60,65 +46,87 @@ __ri void ipu_dither_reference(const macroblock_rgb32 &rgb32, macroblock_rgb16 &
     }
 }
 
-#if defined(_M_X86)
+// The same steps work a half row at a time with SSE4 or NEON, or a whole row at a time with AVX2.
+#if _M_SSE >= 0x501
+using DitherVector = GSVector8i;
+#else
+using DitherVector = GSVector4i;
+#endif
+
+__fi static DitherVector DitherConstant(int x, int y, int z, int w)
+{
+#if _M_SSE >= 0x501
+    return GSVector8i::broadcast128(GSVector4i(x, y, z, w));
+#else
+    return GSVector4i(x, y, z, w);
+#endif
+}
 
-__ri void ipu_dither_sse2(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte)
+__ri void ipu_dither(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte)
 {
-    const __m128i alpha_test = _mm_set1_epi16(0x40);
-    const __m128i dither_add_matrix[] = {
-        _mm_setr_epi32(0x00000000, 0x00000000, 0x00000000, 0x00010101),
-        _mm_setr_epi32(0x00020202, 0x00000000, 0x00030303, 0x00000000),
-        _mm_setr_epi32(0x00000000, 0x00010101, 0x00000000, 0x00000000),
-        _mm_setr_epi32(0x00030303, 0x00000000, 0x00020202, 0x00000000),
+    const DitherVector alpha_test(0x00400040);
+    const DitherVector dither_add_matrix[] = {
+        DitherConstant(0x00000000, 0x00000000, 0x00000000, 0x00010101),
+        DitherConstant(0x00020202, 0x00000000, 0x00030303, 0x00000000),
+        DitherConstant(0x00000000, 0x00010101, 0x00000000, 0x00000000),
+        DitherConstant(0x00030303, 0x00000000, 0x00020202, 0x00000000),
     };
-    const __m128i dither_sub_matrix[] = {
-        _mm_setr_epi32(0x00040404, 0x00000000, 0x00030303, 0x00000000),
-        _mm_setr_epi32(0x00000000, 0x00020202, 0x00000000, 0x00010101),
-        _mm_setr_epi32(0x00030303, 0x00000000, 0x00040404, 0x00000000),
-        _mm_setr_epi32(0x00000000, 0x00010101, 0x00000000, 0x00020202),
+    const DitherVector dither_sub_matrix[] = {
+        DitherConstant(0x00040404, 0x00000000, 0x00030303, 0x00000000),
+        DitherConstant(0x00000000, 0x00020202, 0x00000000, 0x00010101),
+        DitherConstant(0x00030303, 0x00000000, 0x00040404, 0x00000000),
+        DitherConstant(0x00000000, 0x00010101, 0x00000000, 0x00020202),
     };
     for (int i = 0; i < 16; ++i) {
-        const __m128i dither_add = dither_add_matrix[i & 3];
-        const __m128i dither_sub = dither_sub_matrix[i & 3];
-        for (int n = 0; n < 2; ++n) {
-            __m128i rgba_8_0123 = _mm_load_si128(reinterpret_cast<const __m128i *>(&rgb32.c[i][n * 8]));
-            __m128i rgba_8_4567 = _mm_load_si128(reinterpret_cast<const __m128i *>(&rgb32.c[i][n * 8 + 4]));
+        const DitherVector dither_add = dither_add_matrix[i & 3];
+        const DitherVector dither_sub = dither_sub_matrix[i & 3];
+        for (int n = 0; n < 16; n += sizeof(DitherVector) / 2) {
+#if _M_SSE >= 0x501
+            // Pair pixels 0-3 with 8-11 and 4-7 with 12-15, so each 128-bit lane works on 8 pixels in order.
+            const GSVector8i rgba_8_0_7 = GSVector8i::load<false>(&rgb32.c[i][0]);
+            const GSVector8i rgba_8_8_15 = GSVector8i::load<false>(&rgb32.c[i][8]);
+            DitherVector rgba_8_0123 = rgba_8_0_7.ac(rgba_8_8_15);
+            DitherVector rgba_8_4567 = rgba_8_0_7.bd(rgba_8_8_15);
+#else
+            DitherVector rgba_8_0123 = GSVector4i::load<true>(&rgb32.c[i][n]);
+            DitherVector rgba_8_4567 = GSVector4i::load<true>(&rgb32.c[i][n + 4]);
+#endif
 
             // Dither and clamp
             if (dte) {
-                rgba_8_0123 = _mm_adds_epu8(rgba_8_0123, dither_add);
-                rgba_8_0123 = _mm_subs_epu8(rgba_8_0123, dither_sub);
-                rgba_8_4567 = _mm_adds_epu8(rgba_8_4567, dither_add);
-                rgba_8_4567 = _mm_subs_epu8(rgba_8_4567, dither_sub);
+                rgba_8_0123 = rgba_8_0123.addus8(dither_add).subus8(dither_sub);
+                rgba_8_4567 = rgba_8_4567.addus8(dither_add).subus8(dither_sub);
             }
 
             // Split into channel components and extend to 16 bits
-            const __m128i rgba_16_0415 = _mm_unpacklo_epi8(rgba_8_0123, rgba_8_4567);
-            const __m128i rgba_16_2637 = _mm_unpackhi_epi8(rgba_8_0123, rgba_8_4567);
-            const __m128i rgba_32_0246 = _mm_unpacklo_epi8(rgba_16_0415, rgba_16_2637);
-            const __m128i rgba_32_1357 = _mm_unpackhi_epi8(rgba_16_0415, rgba_16_2637);
-            const __m128i rg_64_01234567 = _mm_unpacklo_epi8(rgba_32_0246, rgba_32_1357);
-            const __m128i ba_64_01234567 = _mm_unpackhi_epi8(rgba_32_0246, rgba_32_1357);
-
-            const __m128i zero = _mm_setzero_si128();
-            __m128i r = _mm_unpacklo_epi8(rg_64_01234567, zero);
-            __m128i g = _mm_unpackhi_epi8(rg_64_01234567, zero);
-            __m128i b = _mm_unpacklo_epi8(ba_64_01234567, zero);
-            __m128i a = _mm_unpackhi_epi8(ba_64_01234567, zero);
+            const DitherVector rgba_16_0415 = rgba_8_0123.upl8(rgba_8_4567);
+            const DitherVector rgba_16_2637 = rgba_8_0123.uph8(rgba_8_4567);
+            const DitherVector rgba_32_0246 = rgba_16_0415.upl8(rgba_16_2637);
+            const DitherVector rgba_32_1357 = rgba_16_0415.uph8(rgba_16_2637);
+            const DitherVector rg_64_01234567 = rgba_32_0246.upl8(rgba_32_1357);
+            const DitherVector ba_64_01234567 = rgba_32_0246.uph8(rgba_32_1357);
+
+            const DitherVector zero = DitherVector::zero();
+            DitherVector r = rg_64_01234567.upl8(zero);
+            DitherVector g = rg_64_01234567.uph8(zero);
+            DitherVector b = ba_64_01234567.upl8(zero);
+            DitherVector a = ba_64_01234567.uph8(zero);
 
             // Create RGBA
-            r = _mm_srli_epi16(r, 3);
-            g = _mm_slli_epi16(_mm_srli_epi16(g, 3), 5);
-            b = _mm_slli_epi16(_mm_srli_epi16(b, 3), 10);
-            a = _mm_slli_epi16(_mm_cmpeq_epi16(a, alpha_test), 15);
+            r = r.srl16<3>();
+            g = g.srl16<3>().sll16<5>();
+            b = b.srl16<3>().sll16<10>();
+            a = a.eq16(alpha_test).sll16<15>();
 
-            const __m128i rgba16 = _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+            const DitherVector rgba16 = (r | g) | (b | a);
 
-            _mm_store_si128(reinterpret_cast<__m128i *>(&rgb16.c[i][n * 8]), rgba16);
+#if _M_SSE >= 0x501
+            GSVector8i::store<false>(&rgb16.c[i][n], rgba16);
+#else
+            GSVector4i::store<true>(&rgb16.c[i][n], rgba16);
+#endif
         }
     }
 }
 
-#endif
-
 MULTI_ISA_UNSHARED_END
@@ -55,6 +55,8 @@ static __fi int IPU1chain() {
 
 void IPU1dma()
 {
+	ipuThreadSync();
+
 	if(!ipu1ch.chcr.STR || ipu1ch.chcr.MOD == 2)
 	{
 		//We MUST stop the IPU from trying to fill the FIFO with more data if the DMA has been suspended
@@ -139,6 +141,8 @@ void IPU1dma()
 
 void IPU0dma()
 {
+	ipuThreadSync();
+
 	if(!ipuRegs.ctrl.OFC)
 	{
 		// This shouldn't happen.
@@ -201,6 +205,8 @@ void IPU0dma()
 
 __fi void dmaIPU0() // fromIPU
 {
+	ipuThreadSync();
+
 	//if (dmacRegs.ctrl.STS == STS_fromIPU) DevCon.Warning("DMA Stall enabled on IPU0");
 
 	if (dmacRegs.ctrl.STS == STS_fromIPU)   // STS == fromIPU - Initial settings
@@ -231,6 +237,8 @@ __fi void dmaIPU0() // fromIPU
 
 __fi void dmaIPU1() // toIPU
 {
+	ipuThreadSync();
+
 	IPU_LOG("IPU1DMAStart QWC %x, MADR %x, CHCR %x, TADR %x", ipu1ch.qwc, ipu1ch.madr, ipu1ch.chcr._u32, ipu1ch.tadr);
 	CPU_SET_DMASTALL(DMAC_TO_IPU, false);
 
@@ -274,6 +282,7 @@ void ipuCMDProcess()
 void ipu0Interrupt()
 {
 	IPU_LOG("ipu0Interrupt: %llx", cpuRegs.cycle);
+	ipuThreadSync();
 
 	if(ipu0ch.qwc > 0)
 	{
@@ -290,6 +299,7 @@ void ipu0Interrupt()
 __fi void ipu1Interrupt()
 {
 	IPU_LOG("ipu1Interrupt %llx:", cpuRegs.cycle);
+	ipuThreadSync();
 
 	if(!IPU1Status.DMAFinished || IPU1Status.InProgress)  //Sanity Check
 	{
@@ -4,13 +4,18 @@
 #pragma once
 
 #include "GS/MultiISA.h"
+#include "common/VectorIntrin.h"
 
 MULTI_ISA_DEF(extern void yuv2rgb_reference();)
 
 #if defined(ARCH_X86)
 
+#if _M_SSE >= 0x501
+#define yuv2rgb yuv2rgb_avx2
+#else
 #define yuv2rgb yuv2rgb_sse2
-MULTI_ISA_DEF(extern void yuv2rgb_sse2();)
+#endif
+MULTI_ISA_DEF(extern void yuv2rgb_sse2(); extern void yuv2rgb_avx2();)
 
 #elif defined(ARCH_ARM64)
 
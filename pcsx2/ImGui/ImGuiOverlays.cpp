@@ -72,6 +72,7 @@ SmallString s_capture_line;
 SmallString s_gpu_usage_line;
 SmallString s_gpu_debug_info_line;
 SmallString s_gpu_stats_line;
+SmallString s_ring_stats_lines[static_cast<u32>(PerformanceMetrics::Ring::Count)];
 SmallString s_speed_icon;
 
 constexpr ImU32 white_color = IM_COL32(255, 255, 255, 255);
@@ -539,6 +540,22 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 					FormatUnits(PerformanceMetrics::GetGPUAveragePSInvocations()));
 				DRAW_LINE(osd_font, font_size, s_gpu_stats_line.c_str(), white_color);
 			}
+
+			if (GSConfig.OsdShowRingStats)
+			{
+				static constexpr const char* ring_names[] = {"GS", "VU"};
+				for (u32 ring = 0; ring < std::size(s_ring_stats_lines); ring++)
+				{
+					if (ring == static_cast<u32>(PerformanceMetrics::Ring::VU) && !THREAD_VU1)
+						continue;
+
+					const PerformanceMetrics::RingStats& stats = PerformanceMetrics::GetRingStats(static_cast<PerformanceMetrics::Ring>(ring));
+					s_ring_stats_lines[ring].format("{} Ring: {:.0f} pkt/s | Stall: {:.1f}% ({}) | Idle: {:.1f}% | Peak: {:.1f}%",
+						ring_names[ring], stats.packets_per_second, stats.producer_stall_percent, stats.producer_stalls,
+						stats.consumer_idle_percent, stats.high_water_percent);
+					DRAW_LINE(osd_font, font_size, s_ring_stats_lines[ring].c_str(), white_color);
+				}
+			}
 		}
 		// No refresh yet. Display cached lines.
 		else
@@ -596,6 +613,13 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 			{
 				DRAW_LINE(osd_font, font_size, s_gpu_stats_line.c_str(), white_color);
 			}
+
+			if (GSConfig.OsdShowRingStats)
+			{
+				DRAW_LINE(osd_font, font_size, s_ring_stats_lines[static_cast<u32>(PerformanceMetrics::Ring::GS)].c_str(), white_color);
+				if (THREAD_VU1)
+					DRAW_LINE(osd_font, font_size, s_ring_stats_lines[static_cast<u32>(PerformanceMetrics::Ring::VU)].c_str(), white_color);
+			}
 		}
 
 		// Check every OSD frame because this is an animation.
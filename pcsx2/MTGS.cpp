@@ -7,6 +7,7 @@
 #include "MTVU.h"
 #include "Host.h"
 #include "IconsFontAwesome.h"
+#include "PerformanceMetrics.h"
 #include "VMManager.h"
 
 #include "common/FPControl.h"
@@ -82,6 +83,9 @@ namespace MTGS
 
 	static std::mutex s_mtx_RingBufferBusy2; // Gets released on semaXGkick waiting...
 	static Threading::WorkSema s_sem_event;
+	static Threading::SpinPolicy s_idle_spin;
+	static Threading::SpinPolicy s_wait_spin;
+	static PerformanceMetrics::RingCounters s_ring_counters(RingBufferSize);
 	static Threading::UserspaceSemaphore s_sem_OnRingReset;
 	static Threading::UserspaceSemaphore s_sem_Vsync;
 
@@ -110,6 +114,21 @@ const Threading::ThreadHandle& MTGS::GetThreadHandle()
 	return s_thread;
 }
 
+Threading::SpinPolicy& MTGS::GetIdleSpinPolicy()
+{
+	return s_idle_spin;
+}
+
+Threading::SpinPolicy& MTGS::GetWaitSpinPolicy()
+{
+	return s_wait_spin;
+}
+
+PerformanceMetrics::RingCounters& MTGS::GetRingCounters()
+{
+	return s_ring_counters;
+}
+
 bool MTGS::IsOpen()
 {
 	return s_open_flag.load(std::memory_order_acquire);
@@ -335,7 +354,7 @@ void MTGS::MainLoop()
 		else
 		{
 			mtvu_lock.unlock();
-			s_sem_event.WaitForWork();
+			s_sem_event.WaitForWork(s_idle_spin);
 			mtvu_lock.lock();
 		}
 
@@ -344,9 +363,11 @@ void MTGS::MainLoop()
 
 		// note: m_ReadPos is intentionally not volatile, because it should only
 		// ever be modified by this thread.
+		u32 packets = 0;
 		while (s_ReadPos.load(std::memory_order_relaxed) != s_WritePos.load(std::memory_order_acquire))
 		{
 			const unsigned int local_ReadPos = s_ReadPos.load(std::memory_order_relaxed);
+			packets++;
 
 			pxAssert(local_ReadPos < RingBufferSize);
 
@@ -582,6 +603,8 @@ void MTGS::MainLoop()
 			}
 		}
 
+		s_ring_counters.AddPackets(packets);
+
 		// TODO: With the new race-free WorkSema do we still need these?
 
 		// Safety valve in case standard signals fail for some reason -- this ensures the EEcore
@@ -645,7 +668,7 @@ void MTGS::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 	}
 	else
 	{
-		if (!s_sem_event.WaitForEmpty())
+		if (!s_sem_event.WaitForEmpty(s_wait_spin))
 			pxFailRel("MTGS Thread Died");
 	}
 
@@ -728,6 +751,8 @@ void MTGS::GenericStall(uint size)
 
 	if (freeroom <= size)
 	{
+		const u64 stall_start = GetCPUTicks();
+
 		// writepos will overlap readpos if we commit the data, so we need to wait until
 		// readpos is out past the end of the future write pos, or until it wraps around
 		// (in which case writepos will be >= readpos).
@@ -788,7 +813,11 @@ void MTGS::GenericStall(uint size)
 					break;
 			}
 		}
+
+		s_ring_counters.AddStall(GetCPUTicks() - stall_start);
 	}
+
+	s_ring_counters.UpdateHighWater(RingBufferSize - freeroom + size);
 }
 
 void MTGS::PrepDataPacket(Command cmd, u32 size)
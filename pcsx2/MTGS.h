@@ -16,6 +16,11 @@
 // and writes stay synchronized.  Warning: the debug stack is VERY slow.
 //#define RINGBUF_DEBUG_STACK
 
+namespace PerformanceMetrics
+{
+	struct RingCounters;
+}
+
 namespace MTGS
 {
 	using AsyncCallType = std::function<void()>;
@@ -44,6 +49,11 @@ namespace MTGS
 	const Threading::ThreadHandle& GetThreadHandle();
 	bool IsOpen();
 
+	/// Wait policies for the GS thread waiting for packets, and the EE thread waiting for the GS to catch up.
+	Threading::SpinPolicy& GetIdleSpinPolicy();
+	Threading::SpinPolicy& GetWaitSpinPolicy();
+	PerformanceMetrics::RingCounters& GetRingCounters();
+
 	/// Starts the thread, if it hasn't already been started.
 	void StartThread();
 
@@ -131,12 +131,14 @@ void VU_Thread::ExecuteRingBuffer()
 
 	for (;;)
 	{
-		semaEvent.WaitForWork();
+		semaEvent.WaitForWork(idleSpinPolicy);
 		if (m_shutdown_flag.load(std::memory_order_acquire))
 			break;
 
+		u32 packets = 0;
 		while (m_ato_read_pos.load(std::memory_order_relaxed) != GetWritePos())
 		{
+			packets++;
 			u32 tag = Read();
 			switch (tag)
 			{
@@ -202,6 +204,8 @@ void VU_Thread::ExecuteRingBuffer()
 
 			CommitReadPos();
 		}
+
+		ringCounters.AddPackets(packets);
 	}
 
 	semaEvent.Kill();
@@ -211,6 +215,7 @@ void VU_Thread::ExecuteRingBuffer()
 // Should only be called by ReserveSpace()
 __ri void VU_Thread::WaitOnSize(s32 size)
 {
+	u64 stall_start = 0;
 	for (;;)
 	{
 		s32 readPos = GetReadPos();
@@ -223,6 +228,8 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 		// Note: a wait lock instead of a yield also helps to avoid the bug.
 		if (readPos > m_write_pos + size + _4kb)
 			break; // Enough free front space
+		if (stall_start == 0)
+			stall_start = GetCPUTicks();
 		{          // Let MTVU run to free up buffer space
 			KickStart();
 			// Locking might trigger a full flush of the ring buffer. Yield
@@ -232,6 +239,9 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 			std::this_thread::yield();
 		}
 	}
+
+	if (stall_start != 0)
+		ringCounters.AddStall(GetCPUTicks() - stall_start);
 }
 
 // Makes sure theres enough room in the ring buffer
@@ -252,6 +262,7 @@ void VU_Thread::ReserveSpace(s32 size)
 	}
 
 	WaitOnSize(size);
+	ringCounters.UpdateHighWater(((m_write_pos - GetReadPos()) & (buffer_size - 1)) + size);
 }
 
 // Use this when reading read_pos from ee thread
@@ -435,7 +446,7 @@ bool VU_Thread::IsDone()
 void VU_Thread::WaitVU()
 {
 	MTVU_LOG("MTVU - WaitVU!");
-	semaEvent.WaitForEmpty();
+	semaEvent.WaitForEmpty(waitSpinPolicy);
 }
 
 void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst)
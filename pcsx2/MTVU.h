@@ -3,6 +3,7 @@
 
 #pragma once
 #include "common/Threading.h"
+#include "PerformanceMetrics.h"
 #include "Vif.h"
 #include "Vif_Dma.h"
 #include "VUmicro.h"
@@ -34,6 +35,9 @@ public:
 	alignas(16)  vifStruct        vif;
 	alignas(16)  VIFregisters     vifRegs;
 	Threading::UserspaceSemaphore semaXGkick;
+	Threading::SpinPolicy idleSpinPolicy; // VU thread waiting for work
+	Threading::SpinPolicy waitSpinPolicy; // EE thread waiting for the VU thread to finish
+	PerformanceMetrics::RingCounters ringCounters{buffer_size};
 	std::atomic<unsigned int> vuCycles[4]; // Used for VU cycle stealing hack
 	u32 vuCycleIdx;  // Used for VU cycle stealing hack
 	u32 vuFBRST;
@@ -10,14 +10,19 @@
 #include "VMManager.h"
 #include "vtlb.h"
 #include "common/Error.h"
+#include "common/StringUtil.h"
 #include "common/Threading.h"
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <mutex>
 #include <span>
 #include <sys/types.h>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "fmt/format.h"
 
@@ -47,6 +52,8 @@
 			(a) = -1; \
 		} \
 	} while (0)
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
@@ -62,6 +69,8 @@
 			(a) = -1; \
 		} \
 	} while (0)
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
@@ -110,6 +119,93 @@ namespace PINEServer
 	// Whether the socket processing thread should stop executing/is stopped.
 	static std::atomic_bool s_end{true};
 
+	// Serializes writes to s_msgsock between replies and vsync pushes, and
+	// protects it from being closed while the push thread uses it.
+	static std::mutex s_write_mutex;
+	// Incremented whenever s_msgsock changes, protected by s_write_mutex.
+	static u32 s_client_generation = 0;
+
+	// Thread sending subscribed memory regions, so the CPU thread never
+	// blocks on the socket.
+	static std::thread s_push_thread;
+	static std::mutex s_push_mutex;
+	static std::condition_variable s_push_cv;
+	// Regions (address, size) subscribed to by the client, protected by s_push_mutex.
+	static std::vector<std::pair<u32, u32>> s_push_regions;
+	// Latest vsync message waiting to be sent, protected by s_push_mutex.
+	static std::vector<u8> s_push_buffer;
+	static bool s_push_pending = false;
+	// Client which subscribed, frames for any other client are dropped.
+	static u32 s_push_client = 0;
+	static u32 s_push_counter = 0;
+	// Lets VSync() return without locking when nothing is subscribed.
+	static std::atomic_bool s_has_subscription{false};
+
+	/**
+	 * Shared memory channel, created on request of the client.
+	 * Layout of the mapping, all offsets relative to its start:
+	 *   0:                  SharedMemoryHeader
+	 *   ring_offset:        ring_entries SharedMemoryWrite entries
+	 *   snapshot_offset[i]: two snapshots of EE RAM, ram_size bytes each
+	 *
+	 * Snapshots are taken at vsync, alternating between both slots. Each
+	 * slot has a sequence number which is odd while the slot is written,
+	 * so a reader copies the slot named by latest and retries if its
+	 * sequence number changed in the meantime.
+	 *
+	 * The ring is written by the client and applied to EE memory at vsync,
+	 * before the snapshot. ring_head and ring_tail are free running, the
+	 * client fills entry ring_head % ring_entries and then increments
+	 * ring_head; the emulator increments ring_tail as it applies entries.
+	 */
+	static constexpr u32 SHM_MAGIC = 0x454E4950; // "PINE"
+	static constexpr u32 SHM_VERSION = 1;
+	static constexpr u32 SHM_RING_ENTRIES = 4096;
+	static constexpr u32 SHM_WRITE_DATA_SIZE = 56;
+	static constexpr u32 SHM_HEADER_SIZE = 4096;
+
+	struct SharedMemoryHeader
+	{
+		u32 magic; /**< SHM_MAGIC. */
+		u32 version; /**< SHM_VERSION. */
+		u32 ram_size; /**< Size of each snapshot. */
+		u32 snapshot_offset[2]; /**< Offset of both snapshot slots. */
+		u32 ring_offset; /**< Offset of the write ring. */
+		u32 ring_entries; /**< Number of entries in the write ring. */
+		u32 latest; /**< Slot of the most recent complete snapshot. */
+		u32 sequence[2]; /**< Sequence number of each slot, odd while written. */
+		u32 frame[2]; /**< Vsync counter of each slot. */
+		alignas(64) u32 ring_head; /**< Next entry written by the client. */
+		alignas(64) u32 ring_tail; /**< Next entry applied by the emulator. */
+	};
+	static_assert(sizeof(SharedMemoryHeader) <= SHM_HEADER_SIZE);
+
+	struct SharedMemoryWrite
+	{
+		u32 address; /**< EE address to write to. */
+		u32 size; /**< Number of bytes in data, at most SHM_WRITE_DATA_SIZE. */
+		u8 data[SHM_WRITE_DATA_SIZE]; /**< Data to write. */
+	};
+	static_assert(sizeof(SharedMemoryWrite) == 64);
+
+	// Protects the mapping from being destroyed while the CPU thread uses it.
+	static std::mutex s_shm_mutex;
+	static std::atomic_bool s_shm_active{false};
+	static std::string s_shm_name;
+	static u8* s_shm_base = nullptr;
+	static size_t s_shm_size = 0;
+	static u32 s_shm_frame = 0;
+	// The client can write anything to the header, so everything the CPU
+	// thread depends on is kept here and only ever written to the header.
+	static u32 s_shm_ram_size = 0;
+	static u32 s_shm_snapshot_offset[2] = {};
+	static u32 s_shm_latest = 0;
+	static u32 s_shm_sequence[2] = {};
+	static u32 s_shm_ring_tail = 0;
+#ifdef _WIN32
+	static HANDLE s_shm_handle = nullptr;
+#endif
+
 	/**
 	 * Maximum memory used by an IPC message request.
 	 * Equivalent to 50,000 Write64 requests.
@@ -159,6 +255,11 @@ namespace PINEServer
 		MsgUUID = 0xD, /**< Returns the game UUID. */
 		MsgGameVersion = 0xE, /**< Returns the game verion. */
 		MsgStatus = 0xF, /**< Returns the emulator status. */
+		MsgReadBlock = 0x10, /**< Read a block of memory. */
+		MsgWriteBlock = 0x11, /**< Write a block of memory. */
+		MsgReadList = 0x12, /**< Read a list of memory blocks. */
+		MsgSubscribe = 0x13, /**< Send a list of memory blocks on every vsync. */
+		MsgSharedMemory = 0x14, /**< Opens the shared memory channel. */
 		MsgUnimplemented = 0xFF /**< Unimplemented IPC message. */
 	};
 
@@ -192,6 +293,7 @@ namespace PINEServer
 	enum IPCResult : unsigned char
 	{
 		IPC_OK = 0, /**< IPC command successfully completed. */
+		IPC_VSYNC = 1, /**< Unsolicited update of subscribed memory blocks. */
 		IPC_FAIL = 0xFF /**< IPC command failed to complete. */
 	};
 
@@ -199,6 +301,26 @@ namespace PINEServer
 	void MainLoop();
 	void ClientLoop();
 
+	// Thread used to send subscribed memory blocks.
+	void PushLoop();
+
+	/**
+	 * Drops the memory block subscription of the current client.
+	 */
+	static void ClearSubscription();
+
+	/**
+	 * Creates the shared memory channel if it doesn't exist yet.
+	 * return value: false if the mapping couldn't be created.
+	 */
+	static bool CreateSharedMemory();
+	static void DestroySharedMemory();
+
+	/**
+	 * Applies queued writes and takes a snapshot of EE RAM, called at vsync.
+	 */
+	static void UpdateSharedMemory();
+
 	/**
 	 * Internal function, Parses an IPC command.
 	 * buf: buffer containing the IPC command.
@@ -351,8 +473,9 @@ bool PINEServer::Initialize(int slot)
 	s_ret_buffer.resize(MAX_IPC_RETURN_SIZE);
 	s_ipc_buffer.resize(MAX_IPC_SIZE);
 
-	// we start the thread
+	// we start the threads
 	s_thread = std::thread(&PINEServer::MainLoop);
+	s_push_thread = std::thread(&PINEServer::PushLoop);
 
 	return true;
 }
@@ -383,8 +506,8 @@ std::vector<u8>& PINEServer::MakeFailIPC(std::vector<u8>& ret_buffer, uint32_t s
 
 bool PINEServer::AcceptClient()
 {
-	s_msgsock = accept(s_sock, 0, 0);
-	if (s_msgsock < 0)
+	const auto msgsock = accept(s_sock, 0, 0);
+	if (msgsock < 0)
 	{
 		// everything else is non recoverable in our scope
 		// we also mark as recoverable socket errors where it would block a
@@ -404,9 +527,15 @@ bool PINEServer::AcceptClient()
 
 #ifdef __APPLE__
 	int nosigpipe = 1;
-	setsockopt(s_msgsock, SOL_SOCKET, SO_NOSIGPIPE, &nosigpipe, sizeof(nosigpipe));
+	setsockopt(msgsock, SOL_SOCKET, SO_NOSIGPIPE, &nosigpipe, sizeof(nosigpipe));
 #endif
 
+	{
+		std::unique_lock lock(s_write_mutex);
+		s_msgsock = msgsock;
+		s_client_generation++;
+	}
+
 	// Gross C-style cast, but SOCKET is a handle on Windows.
 	Console.WriteLn("PINE: New client with FD %d connected.", (int)s_msgsock);
 	return true;
@@ -424,8 +553,228 @@ void PINEServer::MainLoop()
 		ClientLoop();
 
 		Console.WriteLn("PINE: Client disconnected.");
+		ClearSubscription();
+		DestroySharedMemory();
+
+		std::unique_lock lock(s_write_mutex);
 		safe_close_portable(s_msgsock);
+		s_client_generation++;
+	}
+}
+
+void PINEServer::PushLoop()
+{
+	Threading::SetNameOfCurrentThread("PINE Push");
+
+	std::vector<u8> send_buffer;
+	for (;;)
+	{
+		u32 client;
+		{
+			std::unique_lock lock(s_push_mutex);
+			s_push_cv.wait(lock, []() { return s_push_pending || s_end.load(std::memory_order_acquire); });
+			if (s_end.load(std::memory_order_acquire))
+				return;
+
+			send_buffer.swap(s_push_buffer);
+			s_push_pending = false;
+			client = s_push_client;
+		}
+
+		// the frame may have been taken just before the client disconnected
+		std::unique_lock lock(s_write_mutex);
+		if (client != s_client_generation)
+			continue;
+#ifdef _WIN32
+		if (s_msgsock != INVALID_SOCKET)
+#else
+		if (s_msgsock >= 0)
+#endif
+			write_portable(s_msgsock, send_buffer.data(), send_buffer.size());
+	}
+}
+
+void PINEServer::ClearSubscription()
+{
+	std::unique_lock lock(s_push_mutex);
+	s_has_subscription.store(false, std::memory_order_release);
+	s_push_regions.clear();
+	s_push_pending = false;
+}
+
+bool PINEServer::CreateSharedMemory()
+{
+	std::unique_lock lock(s_shm_mutex);
+	if (s_shm_active.load(std::memory_order_relaxed))
+		return true;
+
+	const u32 ram_size = Ps2MemSize::ExposedRam;
+	const u32 ring_offset = SHM_HEADER_SIZE;
+	const u32 snapshot_offset = ring_offset + SHM_RING_ENTRIES * sizeof(SharedMemoryWrite);
+	const size_t size = snapshot_offset + static_cast<size_t>(ram_size) * 2;
+
+#ifdef _WIN32
+	s_shm_name = fmt::format("{}_pine_{}", PINE_EMULATOR_NAME, s_slot);
+	s_shm_handle = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<u64>(size) >> 32),
+		static_cast<DWORD>(size), StringUtil::UTF8StringToWideString(s_shm_name).c_str());
+	if (!s_shm_handle)
+	{
+		Console.Error("PINE: CreateFileMapping() failed: %u", GetLastError());
+		return false;
+	}
+
+	s_shm_base = static_cast<u8*>(MapViewOfFile(s_shm_handle, FILE_MAP_ALL_ACCESS, 0, 0, size));
+	if (!s_shm_base)
+	{
+		Console.Error("PINE: MapViewOfFile() failed: %u", GetLastError());
+		CloseHandle(s_shm_handle);
+		s_shm_handle = nullptr;
+		return false;
+	}
+#else
+	s_shm_name = fmt::format("/{}.pine.{}", PINE_EMULATOR_NAME, s_slot);
+
+	// a previous instance may have crashed without removing its mapping
+	shm_unlink(s_shm_name.c_str());
+	const int fd = shm_open(s_shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0)
+	{
+		Console.Error("PINE: shm_open() failed: %d", errno);
+		return false;
+	}
+
+	void* base = MAP_FAILED;
+	if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+		base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED)
+	{
+		Console.Error("PINE: Failed to map shared memory: %d", errno);
+		shm_unlink(s_shm_name.c_str());
+		return false;
+	}
+	s_shm_base = static_cast<u8*>(base);
+#endif
+
+	s_shm_size = size;
+	s_shm_frame = 0;
+	s_shm_ram_size = ram_size;
+	s_shm_snapshot_offset[0] = snapshot_offset;
+	s_shm_snapshot_offset[1] = snapshot_offset + ram_size;
+	s_shm_latest = 0;
+	s_shm_sequence[0] = 0;
+	s_shm_sequence[1] = 0;
+	s_shm_ring_tail = 0;
+
+	SharedMemoryHeader* header = reinterpret_cast<SharedMemoryHeader*>(s_shm_base);
+	std::memset(header, 0, sizeof(SharedMemoryHeader));
+	header->magic = SHM_MAGIC;
+	header->version = SHM_VERSION;
+	header->ram_size = ram_size;
+	header->snapshot_offset[0] = s_shm_snapshot_offset[0];
+	header->snapshot_offset[1] = s_shm_snapshot_offset[1];
+	header->ring_offset = ring_offset;
+	header->ring_entries = SHM_RING_ENTRIES;
+
+	s_shm_active.store(true, std::memory_order_release);
+	Console.WriteLn("PINE: Created shared memory '%s' (%zu bytes).", s_shm_name.c_str(), size);
+	return true;
+}
+
+void PINEServer::DestroySharedMemory()
+{
+	std::unique_lock lock(s_shm_mutex);
+	if (!s_shm_active.load(std::memory_order_relaxed))
+		return;
+
+	s_shm_active.store(false, std::memory_order_release);
+
+	// clients which still have it mapped keep their view
+#ifdef _WIN32
+	UnmapViewOfFile(s_shm_base);
+	CloseHandle(s_shm_handle);
+	s_shm_handle = nullptr;
+#else
+	munmap(s_shm_base, s_shm_size);
+	shm_unlink(s_shm_name.c_str());
+#endif
+
+	s_shm_base = nullptr;
+	s_shm_size = 0;
+	s_shm_name = {};
+}
+
+void PINEServer::UpdateSharedMemory()
+{
+	std::unique_lock lock(s_shm_mutex);
+	if (!s_shm_base)
+		return;
+
+	SharedMemoryHeader* header = reinterpret_cast<SharedMemoryHeader*>(s_shm_base);
+
+	// apply the writes queued by the client, ring_head is the only thing read back from the header
+	SharedMemoryWrite* ring = reinterpret_cast<SharedMemoryWrite*>(s_shm_base + SHM_HEADER_SIZE);
+	const u32 head = std::atomic_ref<u32>(header->ring_head).load(std::memory_order_acquire);
+	u32 tail = s_shm_ring_tail;
+	if ((head - tail) > SHM_RING_ENTRIES) [[unlikely]]
+		tail = head - SHM_RING_ENTRIES;
+	for (; tail != head; tail++)
+	{
+		const SharedMemoryWrite& entry = ring[tail % SHM_RING_ENTRIES];
+		const u32 address = entry.address;
+		const u32 size = entry.size;
+		if (size <= SHM_WRITE_DATA_SIZE)
+			vtlb_memSafeWriteBytes(address, entry.data, size);
 	}
+	s_shm_ring_tail = tail;
+	std::atomic_ref<u32>(header->ring_tail).store(tail, std::memory_order_release);
+
+	// snapshot into the slot which isn't the latest one, so readers of it have a whole frame
+	const u32 slot = s_shm_latest ^ 1;
+	std::atomic_ref<u32> sequence(header->sequence[slot]);
+	sequence.store(++s_shm_sequence[slot], std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	std::memcpy(s_shm_base + s_shm_snapshot_offset[slot], eeMem->Main, std::min(s_shm_ram_size, Ps2MemSize::ExposedRam));
+	header->frame[slot] = s_shm_frame++;
+
+	sequence.store(++s_shm_sequence[slot], std::memory_order_release);
+	s_shm_latest = slot;
+	std::atomic_ref<u32>(header->latest).store(slot, std::memory_order_release);
+}
+
+void PINEServer::VSync()
+{
+	if (s_shm_active.load(std::memory_order_acquire))
+		UpdateSharedMemory();
+
+	if (!s_has_subscription.load(std::memory_order_acquire))
+		return;
+
+	std::unique_lock lock(s_push_mutex);
+
+	// if the previous frame hasn't been sent yet, it's replaced by this one
+	// format: size (4 bytes), IPC_VSYNC, vsync counter (4 bytes), data of each block
+	u32 size = 9;
+	for (const auto& [address, length] : s_push_regions)
+		size += length;
+
+	s_push_buffer.resize(size);
+	ToResultVector<u32>(s_push_buffer, size, 0);
+	s_push_buffer[4] = IPC_VSYNC;
+	ToResultVector<u32>(s_push_buffer, s_push_counter++, 5);
+
+	// blocks which aren't backed by memory read as zeroes
+	u32 pos = 9;
+	for (const auto& [address, length] : s_push_regions)
+	{
+		if (!vtlb_memSafeReadBytes(address, &s_push_buffer[pos], length))
+			std::memset(&s_push_buffer[pos], 0, length);
+		pos += length;
+	}
+
+	s_push_pending = true;
+	s_push_cv.notify_one();
 }
 
 void PINEServer::ClientLoop()
@@ -474,6 +823,7 @@ void PINEServer::ClientLoop()
 			res = ParseCommand(ipc_buffer_span.subspan(4), s_ret_buffer, (u32)end_length - 4);
 
 			// if we cannot send back our answer restart the socket
+			std::unique_lock lock(s_write_mutex);
 			if (write_portable(s_msgsock, res.buffer.data(), res.size) < 0)
 				return;
 		}
@@ -484,6 +834,11 @@ void PINEServer::Deinitialize()
 {
 	s_end.store(true, std::memory_order_release);
 
+	{
+		std::unique_lock lock(s_push_mutex);
+		s_push_cv.notify_one();
+	}
+
 #ifndef _WIN32
 	if (!s_socket_name.empty())
 	{
@@ -492,17 +847,32 @@ void PINEServer::Deinitialize()
 	}
 #endif
 
-	// shutdown() is needed, otherwise accept() will still block.
+	// shutdown() is needed, otherwise accept() will still block, and so
+	// would a push to a client which stopped reading.
 #ifdef _WIN32
 	if (s_sock != INVALID_SOCKET)
 		shutdown(s_sock, SD_BOTH);
+	if (s_msgsock != INVALID_SOCKET)
+		shutdown(s_msgsock, SD_BOTH);
 #else
 	if (s_sock >= 0)
 		shutdown(s_sock, SHUT_RDWR);
+	if (s_msgsock >= 0)
+		shutdown(s_msgsock, SHUT_RDWR);
 #endif
 
+	// the push thread can be writing to the message socket, so stop it before closing
+	if (s_push_thread.joinable())
+		s_push_thread.join();
+	ClearSubscription();
+	DestroySharedMemory();
+
 	safe_close_portable(s_sock);
-	safe_close_portable(s_msgsock);
+	{
+		std::unique_lock lock(s_write_mutex);
+		safe_close_portable(s_msgsock);
+		s_client_generation++;
+	}
 
 	if (s_thread.joinable())
 		s_thread.join();
@@ -746,6 +1116,124 @@ PINEServer::IPCBuffer PINEServer::ParseCommand(std::span<u8> buf, std::vector<u8
 				ret_cnt += 4;
 				break;
 			}
+			case MsgReadBlock:
+			{
+				//         MsgReadBlock  address   size
+				// format: 10            YY YY YY YY SS SS SS SS
+				// reply:  XX            size bytes of data
+				if (!VMManager::HasValidVM())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				const u32 a = FromSpan<u32>(buf, buf_cnt);
+				const u32 size = FromSpan<u32>(buf, buf_cnt + 4);
+				if (size >= MAX_IPC_RETURN_SIZE || !SafetyChecks(buf_cnt, 8, ret_cnt, size, buf_size)) [[unlikely]]
+					goto error;
+				if (!vtlb_memSafeReadBytes(a, &ret_buffer[ret_cnt], size))
+					goto error;
+				ret_cnt += size;
+				buf_cnt += 8;
+				break;
+			}
+			case MsgWriteBlock:
+			{
+				//         MsgWriteBlock  address      size         data
+				// format: 11             YY YY YY YY  SS SS SS SS  size bytes
+				if (!VMManager::HasValidVM())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				const u32 a = FromSpan<u32>(buf, buf_cnt);
+				const u32 size = FromSpan<u32>(buf, buf_cnt + 4);
+				if (size >= MAX_IPC_SIZE || !SafetyChecks(buf_cnt, 8 + size, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				if (!vtlb_memSafeWriteBytes(a, &buf[buf_cnt + 8], size))
+					goto error;
+				buf_cnt += 8 + size;
+				break;
+			}
+			case MsgReadList:
+			{
+				//         MsgReadList  count        count * (address, size)
+				// format: 12           NN NN NN NN  YY YY YY YY SS SS SS SS ...
+				// reply:  XX           data of each block, in order
+				if (!VMManager::HasValidVM())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 4, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				const u32 count = FromSpan<u32>(buf, buf_cnt);
+				if (count >= MAX_IPC_SIZE / 8 || !SafetyChecks(buf_cnt, 4 + count * 8, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				buf_cnt += 4;
+				for (u32 i = 0; i < count; i++)
+				{
+					const u32 a = FromSpan<u32>(buf, buf_cnt);
+					const u32 size = FromSpan<u32>(buf, buf_cnt + 4);
+					if (size >= MAX_IPC_RETURN_SIZE || !SafetyChecks(buf_cnt, 8, ret_cnt, size, buf_size)) [[unlikely]]
+						goto error;
+					if (!vtlb_memSafeReadBytes(a, &ret_buffer[ret_cnt], size))
+						goto error;
+					ret_cnt += size;
+					buf_cnt += 8;
+				}
+				break;
+			}
+			case MsgSubscribe:
+			{
+				// Replaces the current subscription, a count of 0 unsubscribes.
+				// After every vsync the client is sent an unsolicited message:
+				//         size         IPC_VSYNC  vsync counter  data of each block, in order
+				// push:   ZZ ZZ ZZ ZZ  01         CC CC CC CC    ...
+				//
+				//         MsgSubscribe  count        count * (address, size)
+				// format: 13            NN NN NN NN  YY YY YY YY SS SS SS SS ...
+				if (!SafetyChecks(buf_cnt, 4, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				const u32 count = FromSpan<u32>(buf, buf_cnt);
+				if (count >= MAX_IPC_SIZE / 8 || !SafetyChecks(buf_cnt, 4 + count * 8, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				buf_cnt += 4;
+
+				std::vector<std::pair<u32, u32>> regions;
+				regions.reserve(count);
+				u32 total_size = 9;
+				for (u32 i = 0; i < count; i++)
+				{
+					const u32 a = FromSpan<u32>(buf, buf_cnt);
+					const u32 size = FromSpan<u32>(buf, buf_cnt + 4);
+					if (size >= MAX_IPC_RETURN_SIZE - total_size) [[unlikely]]
+						goto error;
+					regions.emplace_back(a, size);
+					total_size += size;
+					buf_cnt += 8;
+				}
+
+				std::unique_lock lock(s_push_mutex);
+				s_push_regions = std::move(regions);
+				s_push_pending = false;
+				// only this thread changes the generation, so it can be read without s_write_mutex
+				s_push_client = s_client_generation;
+				s_has_subscription.store(!s_push_regions.empty(), std::memory_order_release);
+				break;
+			}
+			case MsgSharedMemory:
+			{
+				// Creates the shared memory channel, see SharedMemoryHeader for its layout.
+				//        name size    name (null terminated)  mapping size
+				// reply: XX ZZ ZZ ZZ ZZ ...                     SS SS SS SS
+				if (!CreateSharedMemory())
+					goto error;
+				const u32 size = s_shm_name.size() + 1;
+				if (!SafetyChecks(buf_cnt, 0, ret_cnt, size + 8, buf_size)) [[unlikely]]
+					goto error;
+				ToResultVector(ret_buffer, size, ret_cnt);
+				ret_cnt += 4;
+				memcpy(&ret_buffer[ret_cnt], s_shm_name.c_str(), size);
+				ret_cnt += size;
+				ToResultVector(ret_buffer, static_cast<u32>(s_shm_size), ret_cnt);
+				ret_cnt += 4;
+				break;
+			}
 			default:
 			{
 			error:
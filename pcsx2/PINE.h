@@ -19,4 +19,7 @@ namespace PINEServer
 
 	bool Initialize(int slot = PINE_DEFAULT_SLOT);
 	void Deinitialize();
+
+	// Queues the memory blocks the client subscribed to, called on the CPU thread.
+	void VSync();
 } // namespace PINEServer
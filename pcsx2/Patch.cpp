@@ -24,9 +24,11 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 #include <span>
 #include <sstream>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace Patch
@@ -69,6 +71,49 @@ namespace Patch
 		bool null_pointer_encountered = false;
 	};
 
+	// Vsync patches are compiled to a flat program whenever the active list changes, so that applying them every
+	// frame doesn't have to decode commands or run the extended code state machine. Extended code conditionals
+	// become forward jumps, and any group which can't be represented exactly is left to the interpreter.
+	enum class CompiledPatchOpType : u8
+	{
+		EEWrite8,
+		EEWrite16,
+		EEWrite32,
+		EEWrite64,
+		EEWriteBytes,
+		IOPWrite8,
+		IOPWrite16,
+		IOPWrite32,
+		IOPWriteBytes,
+		EEAdd8,
+		EEAdd16,
+		EEAdd32,
+		EEOr8,
+		EEOr16,
+		EEAnd8,
+		EEAnd16,
+		EEXor8,
+		EEXor16,
+		EEFill32,
+		EECopy8,
+		EEJumpIf8,
+		EEJumpIf16,
+		Interpret,
+	};
+
+	struct CompiledPatchOp
+	{
+		CompiledPatchOpType type;
+		u8 cond; // D-code condition for EEJumpIf*
+		u32 addr; // EECopy8: source address
+		u32 count; // EEFill32/EECopy8: iterations, Interpret: number of commands
+		u32 arg; // EEFill32: address step, EECopy8: destination, EEJumpIf*: target op, Interpret: first command
+		u32 step; // EEFill32: value step
+		u64 value;
+		const PatchCommand* command; // *WriteBytes
+		const u8* host; // IOPWrite*: pre-resolved pointer into IOP RAM for the comparison read
+	};
+
 	namespace PatchFunc
 	{
 		static void patch(PatchGroup* group, const std::string_view cmd, const std::string_view param);
@@ -103,7 +148,26 @@ namespace Patch
 		requires std::is_base_of_v<MemoryInterface, EEMemory> &&
 	             std::is_base_of_v<MemoryInterface, IOPMemory>
 	void ApplyPatch(const PatchCommand* p, EEMemory& ee, IOPMemory& iop, ExtendedState& state);
-	static void ApplyDynaPatch(const DynamicPatch& patch, u32 address);
+	template <typename ReadWord, typename WriteWord>
+	static void ApplyDynaPatch(const DynamicPatch& patch, u32 address, const ReadWord& read_word, const WriteWord& write_word);
+	static void CompileVsyncPatches();
+	static void CompileVsyncProgram(const std::vector<const PatchCommand*>& patches,
+		std::vector<CompiledPatchOp>* program, std::vector<const PatchCommand*>* program_commands);
+	template <typename EEMemory, typename IOPMemory>
+		requires std::is_base_of_v<MemoryInterface, EEMemory> &&
+	             std::is_base_of_v<MemoryInterface, IOPMemory>
+	static void RunVsyncProgram(std::span<const CompiledPatchOp> program,
+		std::span<const PatchCommand* const> program_commands, EEMemory& ee, IOPMemory& iop);
+	static void CompilePatchGroup(std::span<const PatchCommand* const> group, std::vector<CompiledPatchOp>* program,
+		std::vector<const PatchCommand*>* program_commands);
+	static bool CompileExtendedCodes(std::span<const PatchCommand* const> group, std::vector<CompiledPatchOp>* program,
+		std::vector<const PatchCommand*>* program_commands);
+	struct DynamicPatchIndex;
+	static void BuildDynamicPatchIndex(DynamicPatchIndex* index, const std::vector<DynamicPatch>& pnach_patches,
+		const std::vector<DynamicPatch>& gamedb_patches);
+	template <typename ReadWord, typename WriteWord>
+	static void ApplyDynamicPatchIndex(const DynamicPatchIndex& index, u32 pc, const ReadWord& read_word, const WriteWord& write_word);
+	static void RebuildDynamicPatchIndex();
 	template <typename Memory>
 		requires std::is_base_of_v<MemoryInterface, Memory>
 	static void writeCheat(Memory& memory, ExtendedState& state);
@@ -131,8 +195,27 @@ namespace Patch
 	static u32 s_cheats_counts = 0;
 
 	static std::vector<const PatchCommand*> s_active_patches;
+	static std::vector<CompiledPatchOp> s_vsync_program;
+	static std::vector<const PatchCommand*> s_vsync_program_commands;
 	static std::vector<DynamicPatch> s_active_gamedb_dynamic_patches;
 	static std::vector<DynamicPatch> s_active_pnach_dynamic_patches;
+
+	// Dynamic patches are looked up by the first word of their pattern, so the per-instruction cost during
+	// recompilation depends on the number of distinct pattern offsets rather than the number of patches.
+	struct DynamicPatchIndex
+	{
+		struct Group
+		{
+			u32 offset;
+			std::unordered_map<u32, std::vector<u32>> patches; // first pattern value -> indices into patches
+		};
+
+		std::vector<const DynamicPatch*> patches; // pnach patches first, then GameDB
+		std::vector<Group> groups;
+		std::vector<u32> unconditional; // patches with an empty pattern
+	};
+	static DynamicPatchIndex s_dynamic_patch_index;
+
 	static std::vector<std::string> s_enabled_cheats;
 	static std::vector<std::string> s_enabled_patches;
 	static std::vector<std::string> s_just_enabled_cheats;
@@ -723,6 +806,7 @@ void Patch::ReloadPatches(const std::string& serial, u32 crc, bool reload_files,
 	if (reload_files)
 	{
 		s_gamedb_patches.clear();
+		s_active_gamedb_dynamic_patches.clear();
 
 		const GameDatabaseSchema::GameEntry* game = GameDatabase::findGame(serial);
 		if (game)
@@ -813,6 +897,8 @@ void Patch::UpdateActivePatches(bool reload_enabled_list, bool verbose, bool ver
 		}
 	}
 
+	CompileVsyncPatches();
+	RebuildDynamicPatchIndex();
 	if ((!s_active_gamedb_dynamic_patches.empty() || !s_active_pnach_dynamic_patches.empty()) && Cpu)
 		Cpu->Reset();
 }
@@ -874,8 +960,11 @@ void Patch::UnloadPatches()
 	s_override_aspect_ratio = {};
 	s_patches_crc = 0;
 	s_active_patches = {};
+	s_vsync_program = {};
+	s_vsync_program_commands = {};
 	s_active_pnach_dynamic_patches = {};
 	s_active_gamedb_dynamic_patches = {};
+	RebuildDynamicPatchIndex();
 	s_enabled_patches = {};
 	s_enabled_cheats = {};
 	decltype(s_cheat_patches)().swap(s_cheat_patches);
@@ -1111,8 +1200,636 @@ void Patch::ApplyVsyncPatches()
 {
 	EEMemoryInterface ee;
 	IOPMemoryInterface iop;
-	ApplyPatches(s_active_patches, PPT_CONTINUOUSLY, ee, iop);
-	ApplyPatches(s_active_patches, PPT_COMBINED_0_1, ee, iop);
+	RunVsyncProgram(s_vsync_program, s_vsync_program_commands, ee, iop);
+}
+
+u32 Patch::ApplyCompiledVsyncPatches(const std::vector<const PatchCommand*>& patches, MemoryInterface& ee,
+	MemoryInterface& iop)
+{
+	std::vector<CompiledPatchOp> program;
+	std::vector<const PatchCommand*> program_commands;
+	CompileVsyncProgram(patches, &program, &program_commands);
+	RunVsyncProgram(program, program_commands, ee, iop);
+
+	return static_cast<u32>(std::count_if(program.begin(), program.end(),
+		[](const CompiledPatchOp& op) { return op.type == CompiledPatchOpType::Interpret; }));
+}
+
+template <typename EEMemory, typename IOPMemory>
+	requires std::is_base_of_v<MemoryInterface, EEMemory> &&
+             std::is_base_of_v<MemoryInterface, IOPMemory>
+void Patch::RunVsyncProgram(std::span<const CompiledPatchOp> program,
+	std::span<const PatchCommand* const> program_commands, EEMemory& ee, IOPMemory& iop)
+{
+	const u32 size = static_cast<u32>(program.size());
+	for (u32 pc = 0; pc < size;)
+	{
+		const CompiledPatchOp& op = program[pc++];
+		switch (op.type)
+		{
+			case CompiledPatchOpType::EEWrite8:
+			{
+				if (ee.Read8(op.addr) != static_cast<u8>(op.value))
+					ee.Write8(op.addr, static_cast<u8>(op.value));
+				break;
+			}
+			case CompiledPatchOpType::EEWrite16:
+			{
+				if (ee.Read16(op.addr) != static_cast<u16>(op.value))
+					ee.Write16(op.addr, static_cast<u16>(op.value));
+				break;
+			}
+			case CompiledPatchOpType::EEWrite32:
+			{
+				if (ee.Read32(op.addr) != static_cast<u32>(op.value))
+					ee.Write32(op.addr, static_cast<u32>(op.value));
+				break;
+			}
+			case CompiledPatchOpType::EEWrite64:
+			{
+				if (ee.Read64(op.addr) != op.value)
+					ee.Write64(op.addr, op.value);
+				break;
+			}
+			case CompiledPatchOpType::EEWriteBytes:
+			{
+				ee.IdempotentWriteBytes(op.addr, op.command->data_ptr, static_cast<u32>(op.command->data));
+				break;
+			}
+			case CompiledPatchOpType::IOPWrite8:
+			{
+				const u8 current = op.host ? *op.host : iop.Read8(op.addr);
+				if (current != static_cast<u8>(op.value))
+					iop.Write8(op.addr, static_cast<u8>(op.value));
+				break;
+			}
+			case CompiledPatchOpType::IOPWrite16:
+			{
+				const u16 current = op.host ? *reinterpret_cast<const u16*>(op.host) : iop.Read16(op.addr);
+				if (current != static_cast<u16>(op.value))
+					iop.Write16(op.addr, static_cast<u16>(op.value));
+				break;
+			}
+			case CompiledPatchOpType::IOPWrite32:
+			{
+				const u32 current = op.host ? *reinterpret_cast<const u32*>(op.host) : iop.Read32(op.addr);
+				if (current != static_cast<u32>(op.value))
+					iop.Write32(op.addr, static_cast<u32>(op.value));
+				break;
+			}
+			case CompiledPatchOpType::IOPWriteBytes:
+			{
+				iop.IdempotentWriteBytes(op.addr, op.command->data_ptr, static_cast<u32>(op.command->data));
+				break;
+			}
+			case CompiledPatchOpType::EEAdd8:
+			{
+				ee.Write8(op.addr, static_cast<u8>(ee.Read8(op.addr) + static_cast<u8>(op.value)));
+				break;
+			}
+			case CompiledPatchOpType::EEAdd16:
+			{
+				ee.Write16(op.addr, static_cast<u16>(ee.Read16(op.addr) + static_cast<u16>(op.value)));
+				break;
+			}
+			case CompiledPatchOpType::EEAdd32:
+			{
+				ee.Write32(op.addr, ee.Read32(op.addr) + static_cast<u32>(op.value));
+				break;
+			}
+			case CompiledPatchOpType::EEOr8:
+			{
+				ee.Write8(op.addr, static_cast<u8>(ee.Read8(op.addr) | static_cast<u8>(op.value)));
+				break;
+			}
+			case CompiledPatchOpType::EEOr16:
+			{
+				ee.Write16(op.addr, static_cast<u16>(ee.Read16(op.addr) | static_cast<u16>(op.value)));
+				break;
+			}
+			case CompiledPatchOpType::EEAnd8:
+			{
+				ee.Write8(op.addr, static_cast<u8>(ee.Read8(op.addr) & static_cast<u8>(op.value)));
+				break;
+			}
+			case CompiledPatchOpType::EEAnd16:
+			{
+				ee.Write16(op.addr, static_cast<u16>(ee.Read16(op.addr) & static_cast<u16>(op.value)));
+				break;
+			}
+			case CompiledPatchOpType::EEXor8:
+			{
+				ee.Write8(op.addr, static_cast<u8>(ee.Read8(op.addr) ^ static_cast<u8>(op.value)));
+				break;
+			}
+			case CompiledPatchOpType::EEXor16:
+			{
+				ee.Write16(op.addr, static_cast<u16>(ee.Read16(op.addr) ^ static_cast<u16>(op.value)));
+				break;
+			}
+			case CompiledPatchOpType::EEFill32:
+			{
+				for (u32 i = 0; i < op.count; i++)
+				{
+					const u32 addr = op.addr + (i * op.arg);
+					const u32 value = static_cast<u32>(op.value) + (op.step * i);
+					if (ee.Read32(addr) != value)
+						ee.Write32(addr, value);
+				}
+				break;
+			}
+			case CompiledPatchOpType::EECopy8:
+			{
+				for (u32 i = 0; i < op.count; i++)
+				{
+					const u8 value = ee.Read8(op.addr + i);
+					const u32 addr = (op.arg + i) & 0x0FFFFFFF;
+					if (ee.Read8(addr) != value)
+						ee.Write8(addr, value);
+				}
+				break;
+			}
+			case CompiledPatchOpType::EEJumpIf8:
+			case CompiledPatchOpType::EEJumpIf16:
+			{
+				const u32 mem = (op.type == CompiledPatchOpType::EEJumpIf8) ? ee.Read8(op.addr) : ee.Read16(op.addr);
+				const u32 value = static_cast<u32>(op.value);
+				bool skip;
+				switch (op.cond)
+				{
+					case 0:
+						skip = (mem != value);
+						break;
+					case 1:
+						skip = (mem == value);
+						break;
+					case 2:
+						skip = (mem >= value);
+						break;
+					case 3:
+						skip = (mem <= value);
+						break;
+					case 4:
+						skip = (mem & value) != 0;
+						break;
+					case 5:
+						skip = (mem & value) == 0;
+						break;
+					case 6:
+						skip = (mem | value) != 0;
+						break;
+					default:
+						skip = (mem | value) == 0;
+						break;
+				}
+				if (skip)
+					pc = op.arg;
+				break;
+			}
+			case CompiledPatchOpType::Interpret:
+			{
+				ExtendedState state;
+				for (u32 i = 0; i < op.count; i++)
+					ApplyPatch(program_commands[op.arg + i], ee, iop, state);
+				break;
+			}
+		}
+	}
+}
+
+void Patch::CompileVsyncPatches()
+{
+	s_vsync_program.clear();
+	s_vsync_program_commands.clear();
+	CompileVsyncProgram(s_active_patches, &s_vsync_program, &s_vsync_program_commands);
+
+	// IOP RAM is never remapped, so aligned accesses to it can be compared through a host pointer.
+	for (CompiledPatchOp& op : s_vsync_program)
+	{
+		u32 size;
+		switch (op.type)
+		{
+			case CompiledPatchOpType::IOPWrite8:
+				size = 1;
+				break;
+			case CompiledPatchOpType::IOPWrite16:
+				size = 2;
+				break;
+			case CompiledPatchOpType::IOPWrite32:
+				size = 4;
+				break;
+			default:
+				continue;
+		}
+
+		const u32 paddr = op.addr & 0x1FFFFFFF;
+		if ((paddr & (size - 1)) == 0 && paddr < Ps2MemSize::ExposedIopRam)
+			op.host = iopPhysMem(paddr);
+	}
+
+	const u32 interpreted = static_cast<u32>(std::count_if(s_vsync_program.begin(), s_vsync_program.end(),
+		[](const CompiledPatchOp& op) { return op.type == CompiledPatchOpType::Interpret; }));
+	DevCon.WriteLn(fmt::format("Patch: Compiled vsync patches to {} ops ({} interpreted).", s_vsync_program.size(),
+		interpreted));
+}
+
+void Patch::CompileVsyncProgram(const std::vector<const PatchCommand*>& patches,
+	std::vector<CompiledPatchOp>* program, std::vector<const PatchCommand*>* program_commands)
+{
+	// Same order as the interpreter: all continuous patches, then the combined ones. Extended code state is reset
+	// at each group boundary, and between the two passes.
+	std::vector<const PatchCommand*> group;
+	for (const patch_place_type place : {PPT_CONTINUOUSLY, PPT_COMBINED_0_1})
+	{
+		for (const PatchCommand* patch : patches)
+		{
+			if (!patch)
+			{
+				CompilePatchGroup(group, program, program_commands);
+				group.clear();
+				continue;
+			}
+
+			if (patch->placetopatch == place)
+				group.push_back(patch);
+		}
+
+		CompilePatchGroup(group, program, program_commands);
+		group.clear();
+	}
+}
+
+void Patch::CompilePatchGroup(std::span<const PatchCommand* const> group, std::vector<CompiledPatchOp>* program,
+	std::vector<const PatchCommand*>* program_commands)
+{
+	if (group.empty())
+		return;
+
+	const size_t program_start = program->size();
+	const size_t commands_start = program_commands->size();
+	if (CompileExtendedCodes(group, program, program_commands))
+		return;
+
+	// Couldn't compile the group exactly, so run it through the interpreter.
+	program->resize(program_start);
+	program_commands->resize(commands_start);
+
+	CompiledPatchOp op = {};
+	op.type = CompiledPatchOpType::Interpret;
+	op.arg = static_cast<u32>(program_commands->size());
+	op.count = static_cast<u32>(group.size());
+	program_commands->insert(program_commands->end(), group.begin(), group.end());
+	program->push_back(op);
+}
+
+bool Patch::CompileExtendedCodes(std::span<const PatchCommand* const> group, std::vector<CompiledPatchOp>* program,
+	std::vector<const PatchCommand*>* program_commands)
+{
+	// A decoded extended code, which spans one or more EE extended lines of the group.
+	struct Code
+	{
+		u32 first_line;
+		u32 num_lines;
+		std::optional<CompiledPatchOp> op;
+		u32 skip_lines; // D/E codes
+	};
+
+	std::vector<u32> lines; // group index of each EE extended line
+	for (u32 i = 0; i < static_cast<u32>(group.size()); i++)
+	{
+		if (group[i]->cpu == CPU_EE && group[i]->type == EXTENDED_T)
+			lines.push_back(i);
+	}
+
+	const u32 num_lines = static_cast<u32>(lines.size());
+	std::vector<Code> codes;
+	std::vector<s32> code_at_line(num_lines + 1, -1);
+	for (u32 line = 0; line < num_lines;)
+	{
+		const PatchCommand* p = group[lines[line]];
+		const PatchCommand* next = (line + 1 < num_lines) ? group[lines[line + 1]] : nullptr;
+		const u32 addr = p->addr;
+		const u32 data = static_cast<u32>(p->data);
+
+		Code code = {line, 1, std::nullopt, 0};
+		CompiledPatchOp op = {};
+		switch (addr & 0xF0000000)
+		{
+			case 0x00000000: // 0aaaaaaa 0000000vv
+			case 0x10000000: // 1aaaaaaa 0000vvvv
+			case 0x20000000: // 2aaaaaaa vvvvvvvv
+			{
+				const u32 size = (addr & 0xF0000000) >> 28;
+				op.type = (size == 0) ? CompiledPatchOpType::EEWrite8 :
+						  (size == 1) ? CompiledPatchOpType::EEWrite16 :
+										CompiledPatchOpType::EEWrite32;
+				op.addr = addr & 0x0FFFFFFF;
+				op.value = (size == 0) ? (data & 0xFF) : (size == 1) ? (data & 0xFFFF) : data;
+				code.op = op;
+			}
+			break;
+
+			case 0x30000000:
+			{
+				op.addr = data;
+				switch (addr & 0xFFFF0000)
+				{
+					case 0x30000000: // 300000vv 0aaaaaaa Inc
+					case 0x30100000: // 301000vv 0aaaaaaa Dec
+						op.type = CompiledPatchOpType::EEAdd8;
+						op.value = ((addr & 0xFFFF0000) == 0x30000000) ? (addr & 0xFF) : (0u - (addr & 0xFF));
+						code.op = op;
+						break;
+
+					case 0x30200000: // 3020vvvv 0aaaaaaa Inc
+					case 0x30300000: // 3030vvvv 0aaaaaaa Dec
+						op.type = CompiledPatchOpType::EEAdd16;
+						op.value = ((addr & 0xFFFF0000) == 0x30200000) ? (addr & 0xFFFF) : (0u - (addr & 0xFFFF));
+						code.op = op;
+						break;
+
+					case 0x30400000: // 30400000 0aaaaaaa Inc + Another line
+					case 0x30500000: // 30500000 0aaaaaaa Dec + Another line
+						code.num_lines = 2;
+						if (next)
+						{
+							op.type = CompiledPatchOpType::EEAdd32;
+							op.value = ((addr & 0xFFFF0000) == 0x30400000) ? next->addr : (0u - next->addr);
+							code.op = op;
+						}
+						break;
+
+					default:
+						break;
+				}
+			}
+			break;
+
+			case 0x40000000: // 4aaaaaaa nnnnssss + Another line
+			{
+				code.num_lines = 2;
+				if (next)
+				{
+					op.type = CompiledPatchOpType::EEFill32;
+					op.addr = addr & 0x0FFFFFFF;
+					op.count = (data & 0xFFFF0000) >> 16;
+					op.arg = (data & 0x0000FFFF) * 4;
+					op.value = next->addr;
+					op.step = static_cast<u32>(next->data);
+					code.op = op;
+				}
+			}
+			break;
+
+			case 0x50000000: // 5sssssss nnnnnnnn + Another line
+			{
+				code.num_lines = 2;
+				if (next)
+				{
+					op.type = CompiledPatchOpType::EECopy8;
+					op.addr = addr & 0x0FFFFFFF;
+					op.count = data;
+					op.arg = next->addr;
+					code.op = op;
+				}
+			}
+			break;
+
+			case 0x60000000: // 6aaaaaaa 000000vv + Another line/s
+			{
+				// Pointer chains are rare enough that they aren't worth compiling, but they are self-contained, so
+				// the interpreter can run just the lines of this code.
+				code.num_lines = 2;
+				if (next)
+				{
+					// The second line reads the first pointer, and each following line reads up to two more.
+					const u32 num_pointers = std::max<u32>(next->addr & 0x0000FFFF, 1);
+					code.num_lines += num_pointers / 2;
+				}
+
+				if (line + code.num_lines <= num_lines)
+				{
+					op.type = CompiledPatchOpType::Interpret;
+					op.arg = static_cast<u32>(program_commands->size());
+					op.count = code.num_lines;
+					for (u32 i = 0; i < code.num_lines; i++)
+						program_commands->push_back(group[lines[line + i]]);
+					code.op = op;
+				}
+			}
+			break;
+
+			case 0x70000000:
+			{
+				op.addr = addr & 0x0FFFFFFF;
+				switch (data & 0x00F00000)
+				{
+					case 0x00000000:
+						op.type = CompiledPatchOpType::EEOr8;
+						op.value = data & 0xFF;
+						code.op = op;
+						break;
+					case 0x00100000:
+						op.type = CompiledPatchOpType::EEOr16;
+						op.value = data & 0xFFFF;
+						code.op = op;
+						break;
+					case 0x00200000:
+						op.type = CompiledPatchOpType::EEAnd8;
+						op.value = data & 0xFF;
+						code.op = op;
+						break;
+					case 0x00300000:
+						op.type = CompiledPatchOpType::EEAnd16;
+						op.value = data & 0xFFFF;
+						code.op = op;
+						break;
+					case 0x00400000:
+						op.type = CompiledPatchOpType::EEXor8;
+						op.value = data & 0xFF;
+						code.op = op;
+						break;
+					case 0x00500000:
+						op.type = CompiledPatchOpType::EEXor16;
+						op.value = data & 0xFFFF;
+						code.op = op;
+						break;
+					default:
+						break;
+				}
+			}
+			break;
+
+			case 0xD0000000:
+			case 0xE0000000:
+			{
+				u32 daddr = addr;
+				u32 ddata = data;
+				if ((addr & 0xF0000000) == 0xE0000000)
+				{
+					// Ezyyvvvv taaaaaaa  ->  Daaaaaaa yytzvvvv
+					daddr = 0xD0000000 | (data & 0x0FFFFFFF);
+					ddata = (addr & 0x0000FFFF) | ((addr & 0x00FF0000) << 8) | ((addr & 0x0F000000) >> 8) |
+							((data & 0xF0000000) >> 8);
+				}
+
+				const u8 type = (ddata & 0x000F0000) >> 16;
+				const u8 cond = (ddata & 0x00F00000) >> 20;
+				if (cond <= 7 && type <= 1)
+				{
+					op.type = (type == 0) ? CompiledPatchOpType::EEJumpIf16 : CompiledPatchOpType::EEJumpIf8;
+					op.cond = cond;
+					op.addr = daddr & 0x0FFFFFFF;
+					op.value = (type == 0) ? (ddata & 0xFFFF) : (ddata & 0xFF);
+					code.op = op;
+					code.skip_lines = std::max<u32>((ddata & 0xFF000000) >> 24, 1);
+				}
+			}
+			break;
+
+			default:
+				break;
+		}
+
+		// A multi-line code cut short by the end of the group never takes effect.
+		code.num_lines = std::min(code.num_lines, num_lines - line);
+		if (code.num_lines > 1)
+		{
+			// Other commands in between the lines of a code would run in the middle of it.
+			if (lines[line + code.num_lines - 1] - lines[line] != code.num_lines - 1)
+				return false;
+		}
+
+		code_at_line[line] = static_cast<s32>(codes.size());
+		codes.push_back(std::move(code));
+		line += codes.back().num_lines;
+	}
+	code_at_line[num_lines] = static_cast<s32>(codes.size());
+
+	// Emit ops in group order, with each code placed at its last line, where the interpreter applies it.
+	std::vector<u32> code_op_index(codes.size() + 1);
+	std::vector<std::pair<u32, u32>> jump_fixups; // op index, target code
+	u32 next_code = 0;
+	for (u32 i = 0; i < static_cast<u32>(group.size()); i++)
+	{
+		const PatchCommand* p = group[i];
+		if (p->type == EXTENDED_T)
+		{
+			if (p->cpu != CPU_EE)
+				continue;
+
+			const Code& code = codes[next_code];
+			code_op_index[next_code] = static_cast<u32>(program->size());
+			if (lines[code.first_line + code.num_lines - 1] != i)
+				continue;
+
+			if (code.op.has_value())
+			{
+				if (code.skip_lines > 0)
+				{
+					// Skipping has to land on the start of a code, without passing over any other commands.
+					const u32 target_line = std::min(code.first_line + 1 + code.skip_lines, num_lines);
+					if (code_at_line[target_line] < 0)
+						return false;
+
+					const u32 end = (target_line < num_lines) ? lines[target_line] : static_cast<u32>(group.size());
+					if (end - i != target_line - code.first_line)
+						return false;
+
+					jump_fixups.emplace_back(static_cast<u32>(program->size()), code_at_line[target_line]);
+				}
+
+				program->push_back(code.op.value());
+			}
+
+			next_code++;
+			continue;
+		}
+
+		CompiledPatchOp op = {};
+		op.addr = p->addr;
+		switch (p->cpu)
+		{
+			case CPU_EE:
+			{
+				switch (p->type)
+				{
+					case BYTE_T:
+						op.type = CompiledPatchOpType::EEWrite8;
+						op.value = static_cast<u8>(p->data);
+						break;
+					case SHORT_T:
+						op.type = CompiledPatchOpType::EEWrite16;
+						op.value = static_cast<u16>(p->data);
+						break;
+					case WORD_T:
+						op.type = CompiledPatchOpType::EEWrite32;
+						op.value = static_cast<u32>(p->data);
+						break;
+					case DOUBLE_T:
+						op.type = CompiledPatchOpType::EEWrite64;
+						op.value = p->data;
+						break;
+					case SHORT_BE_T:
+						op.type = CompiledPatchOpType::EEWrite16;
+						op.value = ByteSwap(static_cast<u16>(p->data));
+						break;
+					case WORD_BE_T:
+						op.type = CompiledPatchOpType::EEWrite32;
+						op.value = ByteSwap(static_cast<u32>(p->data));
+						break;
+					case DOUBLE_BE_T:
+						op.type = CompiledPatchOpType::EEWrite64;
+						op.value = ByteSwap(p->data);
+						break;
+					case BYTES_T:
+						op.type = CompiledPatchOpType::EEWriteBytes;
+						op.command = p;
+						break;
+					default:
+						continue;
+				}
+			}
+			break;
+
+			case CPU_IOP:
+			{
+				switch (p->type)
+				{
+					case BYTE_T:
+						op.type = CompiledPatchOpType::IOPWrite8;
+						op.value = static_cast<u8>(p->data);
+						break;
+					case SHORT_T:
+						op.type = CompiledPatchOpType::IOPWrite16;
+						op.value = static_cast<u16>(p->data);
+						break;
+					case WORD_T:
+						op.type = CompiledPatchOpType::IOPWrite32;
+						op.value = static_cast<u32>(p->data);
+						break;
+					case BYTES_T:
+						op.type = CompiledPatchOpType::IOPWriteBytes;
+						op.command = p;
+						break;
+					default:
+						continue;
+				}
+			}
+			break;
+
+			default:
+				continue;
+		}
+
+		program->push_back(op);
+	}
+	code_op_index[codes.size()] = static_cast<u32>(program->size());
+
+	for (const auto& [op_index, target_code] : jump_fixups)
+		(*program)[op_index].arg = code_op_index[target_code];
+
+	return true;
 }
 
 void Patch::ApplyPatches(
@@ -1188,16 +1905,125 @@ bool Patch::IsGloballyToggleablePatch(const PatchInfo& patch_info)
 
 void Patch::ApplyDynamicPatches(u32 pc)
 {
-	for (const auto& dynpatch : s_active_pnach_dynamic_patches)
-		ApplyDynaPatch(dynpatch, pc);
-	for (const auto& dynpatch : s_active_gamedb_dynamic_patches)
-		ApplyDynaPatch(dynpatch, pc);
+	ApplyDynamicPatchIndex(s_dynamic_patch_index, pc,
+		[](u32 address, u32* value) {
+			const u32* word = static_cast<const u32*>(PSM(address));
+			if (!word)
+				return false;
+
+			*value = *word;
+			return true;
+		},
+		[](u32 address, u32 value) { memWrite32(address, value); });
+}
+
+void Patch::ApplyDynamicPatches(u32 pc, MemoryInterface& ee)
+{
+	ApplyDynamicPatchIndex(s_dynamic_patch_index, pc,
+		[&ee](u32 address, u32* value) {
+			bool valid;
+			*value = ee.Read32(address, &valid);
+			return valid;
+		},
+		[&ee](u32 address, u32 value) { ee.Write32(address, value); });
+}
+
+void Patch::ApplyDynamicPatches(const std::vector<DynamicPatch>& pnach_patches,
+	const std::vector<DynamicPatch>& gamedb_patches, u32 pc, MemoryInterface& ee)
+{
+	DynamicPatchIndex index;
+	BuildDynamicPatchIndex(&index, pnach_patches, gamedb_patches);
+	ApplyDynamicPatchIndex(index, pc,
+		[&ee](u32 address, u32* value) {
+			bool valid;
+			*value = ee.Read32(address, &valid);
+			return valid;
+		},
+		[&ee](u32 address, u32 value) { ee.Write32(address, value); });
+}
+
+template <typename ReadWord, typename WriteWord>
+void Patch::ApplyDynamicPatchIndex(const DynamicPatchIndex& index, u32 pc, const ReadWord& read_word, const WriteWord& write_word)
+{
+	// Candidates are applied in load order. Look them up again after each one, because its replacement can
+	// change whether later patches match.
+	u32 next = 0;
+	for (;;)
+	{
+		u32 candidate = std::numeric_limits<u32>::max();
+
+		const auto unconditional = std::lower_bound(index.unconditional.begin(), index.unconditional.end(), next);
+		if (unconditional != index.unconditional.end())
+			candidate = *unconditional;
+
+		for (const DynamicPatchIndex::Group& group : index.groups)
+		{
+			u32 word;
+			if (!read_word(pc + group.offset, &word))
+				continue;
+
+			const auto it = group.patches.find(word);
+			if (it == group.patches.end())
+				continue;
+
+			const auto match = std::lower_bound(it->second.begin(), it->second.end(), next);
+			if (match != it->second.end())
+				candidate = std::min(candidate, *match);
+		}
+
+		if (candidate == std::numeric_limits<u32>::max())
+			return;
+
+		ApplyDynaPatch(*index.patches[candidate], pc, read_word, write_word);
+		next = candidate + 1;
+	}
 }
 
 void Patch::LoadDynamicPatches(const std::vector<DynamicPatch>& patches)
 {
-	for (const DynamicPatch& it : patches)
-		s_active_gamedb_dynamic_patches.push_back(it);
+	s_active_gamedb_dynamic_patches = patches;
+
+	RebuildDynamicPatchIndex();
+}
+
+void Patch::RebuildDynamicPatchIndex()
+{
+	BuildDynamicPatchIndex(&s_dynamic_patch_index, s_active_pnach_dynamic_patches, s_active_gamedb_dynamic_patches);
+}
+
+void Patch::BuildDynamicPatchIndex(DynamicPatchIndex* index, const std::vector<DynamicPatch>& pnach_patches,
+	const std::vector<DynamicPatch>& gamedb_patches)
+{
+	index->patches.clear();
+	index->groups.clear();
+	index->unconditional.clear();
+
+	for (const DynamicPatch& dp : pnach_patches)
+		index->patches.push_back(&dp);
+	for (const DynamicPatch& dp : gamedb_patches)
+		index->patches.push_back(&dp);
+
+	// Indices are added in ascending order, so each bucket stays sorted for lower_bound().
+	for (u32 i = 0; i < static_cast<u32>(index->patches.size()); i++)
+	{
+		const DynamicPatch& dp = *index->patches[i];
+		if (dp.pattern.empty())
+		{
+			index->unconditional.push_back(i);
+			continue;
+		}
+
+		const DynamicPatchEntry& first = dp.pattern.front();
+		auto group = std::find_if(index->groups.begin(), index->groups.end(),
+			[&first](const DynamicPatchIndex::Group& g) { return g.offset == first.offset; });
+		if (group == index->groups.end())
+		{
+			index->groups.push_back(DynamicPatchIndex::Group{first.offset, {}});
+			group = index->groups.end() - 1;
+		}
+
+		group->patches[first.value].push_back(i);
+	}
 }
 
 template <typename Memory>
@@ -1809,11 +2635,13 @@ void Patch::ApplyPatch(const PatchCommand* p, EEMemory& ee, IOPMemory& iop, Exte
 	}
 }
 
-void Patch::ApplyDynaPatch(const DynamicPatch& patch, u32 address)
+template <typename ReadWord, typename WriteWord>
+void Patch::ApplyDynaPatch(const DynamicPatch& patch, u32 address, const ReadWord& read_word, const WriteWord& write_word)
 {
 	for (const auto& pattern : patch.pattern)
 	{
-		if (*static_cast<u32*>(PSM(address + pattern.offset)) != pattern.value)
+		u32 word;
+		if (!read_word(address + pattern.offset, &word) || word != pattern.value)
 			return;
 	}
 
@@ -1821,7 +2649,7 @@ void Patch::ApplyDynaPatch(const DynamicPatch& patch, u32 address)
 	// If everything passes, apply the patch.
 	for (const auto& replacement : patch.replacement)
 	{
-		memWrite32(address + replacement.offset, replacement.value);
+		write_word(address + replacement.offset, replacement.value);
 	}
 }
 
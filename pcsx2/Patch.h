@@ -167,8 +167,19 @@ namespace Patch
 	extern void UnloadPatches();
 
 	/// Functions for Dynamic EE patching.
+	/// LoadDynamicPatches() replaces the GameDB dynamic patches.
 	extern void LoadDynamicPatches(const std::vector<DynamicPatch>& patches);
 	extern void ApplyDynamicPatches(u32 pc);
+	extern void ApplyDynamicPatches(u32 pc, MemoryInterface& ee);
+
+	/// Apply the dynamic patches from the provided lists to the code at pc, the
+	/// same way the active ones are applied: pnach patches are tried before
+	/// GameDB ones.
+	extern void ApplyDynamicPatches(
+		const std::vector<DynamicPatch>& pnach_patches,
+		const std::vector<DynamicPatch>& gamedb_patches,
+		u32 pc,
+		MemoryInterface& ee);
 
 	/// Apply all loaded patches that should be applied when the entry point is
 	/// being recompiled.
@@ -190,6 +201,14 @@ namespace Patch
 		MemoryInterface& ee,
 		MemoryInterface& iop);
 
+	/// Compile the continuous and combined patches from the provided list the
+	/// same way ApplyVsyncPatches() does, and apply them. Returns the number of
+	/// ops which were left to the interpreter.
+	extern u32 ApplyCompiledVsyncPatches(
+		const std::vector<const PatchCommand*>& patches,
+		MemoryInterface& ee,
+		MemoryInterface& iop);
+
 	// Get the total counts of the active game patches.
 	extern u32 GetActiveGameDBPatchesCount();
 	extern u32 GetActivePatchesCount();
@@ -2,8 +2,11 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include <chrono>
+#include <mutex>
 #include <vector>
 
+#include "common/Error.h"
+#include "common/FileSystem.h"
 #include "common/Timer.h"
 #include "common/Threading.h"
 
@@ -15,6 +18,8 @@
 #include "MTVU.h"
 #include "VMManager.h"
 
+#include "fmt/format.h"
+
 static const float UPDATE_INTERVAL = 0.5f;
 
 static float s_fps = 0.0f;
@@ -75,6 +80,101 @@ static double s_average_gpu_ps_invocations = 0.0;
 static u64 s_accumulated_gpu_vs_invocations = 0;
 static u64 s_accumulated_gpu_ps_invocations = 0;
 
+static constexpr u32 NUM_THREAD_WAITS = static_cast<u32>(PerformanceMetrics::ThreadWait::Count);
+static std::array<PerformanceMetrics::WaitHistogram, NUM_THREAD_WAITS> s_wait_histograms = {};
+static std::array<u32, NUM_THREAD_WAITS> s_wait_spin_times = {};
+
+static Threading::SpinPolicy* GetWaitSpinPolicy(PerformanceMetrics::ThreadWait wait)
+{
+	switch (wait)
+	{
+		case PerformanceMetrics::ThreadWait::GSIdle:
+			return &MTGS::GetIdleSpinPolicy();
+		case PerformanceMetrics::ThreadWait::EEWaitingOnGS:
+			return &MTGS::GetWaitSpinPolicy();
+		case PerformanceMetrics::ThreadWait::VUIdle:
+			return THREAD_VU1 ? &vu1Thread.idleSpinPolicy : nullptr;
+		case PerformanceMetrics::ThreadWait::EEWaitingOnVU:
+			return THREAD_VU1 ? &vu1Thread.waitSpinPolicy : nullptr;
+		default:
+			return nullptr;
+	}
+}
+
+static constexpr u32 NUM_RINGS = static_cast<u32>(PerformanceMetrics::Ring::Count);
+static constexpr const char* s_ring_names[NUM_RINGS] = {"GS", "VU"};
+
+struct RingCounterValues
+{
+	u64 packets;
+	u64 stalls;
+	u64 stall_ticks;
+};
+static std::array<PerformanceMetrics::RingStats, NUM_RINGS> s_ring_stats = {};
+static std::array<RingCounterValues, NUM_RINGS> s_last_ring_counters = {};
+static Common::Timer s_ring_stats_dump_time;
+// Written from the GS thread in Update(), started and stopped from the CPU thread.
+static std::mutex s_ring_stats_dump_mutex;
+static FileSystem::ManagedCFilePtr s_ring_stats_dump_file;
+static std::string s_ring_stats_dump_path;
+
+static PerformanceMetrics::RingCounters* GetRingCounters(PerformanceMetrics::Ring ring)
+{
+	if (ring == PerformanceMetrics::Ring::GS)
+		return &MTGS::GetRingCounters();
+	else if (ring == PerformanceMetrics::Ring::VU && THREAD_VU1)
+		return &vu1Thread.ringCounters;
+	else
+		return nullptr;
+}
+
+static void UpdateRingStats(float time)
+{
+	const double ticks_per_second = static_cast<double>(GetTickFrequency());
+	for (u32 i = 0; i < NUM_RINGS; i++)
+	{
+		const PerformanceMetrics::Ring ring = static_cast<PerformanceMetrics::Ring>(i);
+		PerformanceMetrics::RingStats& stats = s_ring_stats[i];
+		stats = {};
+
+		PerformanceMetrics::RingCounters* counters = GetRingCounters(ring);
+		if (!counters)
+			continue;
+
+		RingCounterValues& last = s_last_ring_counters[i];
+		const RingCounterValues current = {counters->packets.load(std::memory_order_relaxed),
+			counters->stalls.load(std::memory_order_relaxed), counters->stall_ticks.load(std::memory_order_relaxed)};
+		const u32 high_water = counters->high_water.exchange(0, std::memory_order_relaxed);
+
+		stats.packets_per_second = static_cast<float>(current.packets - last.packets) / time;
+		stats.producer_stalls = static_cast<u32>(current.stalls - last.stalls);
+		stats.producer_stall_percent =
+			static_cast<float>(static_cast<double>(current.stall_ticks - last.stall_ticks) / ticks_per_second) * 100.0f / time;
+		stats.high_water_percent = static_cast<float>(high_water) * 100.0f / static_cast<float>(counters->size);
+		last = current;
+
+		const PerformanceMetrics::ThreadWait idle_wait =
+			(ring == PerformanceMetrics::Ring::GS) ? PerformanceMetrics::ThreadWait::GSIdle : PerformanceMetrics::ThreadWait::VUIdle;
+		if (Threading::SpinPolicy* policy = GetWaitSpinPolicy(idle_wait))
+			stats.consumer_idle_percent = static_cast<float>(static_cast<double>(policy->CollectWaitTime()) / 1e9) * 100.0f / time;
+	}
+}
+
+static void WriteRingStatsDump()
+{
+	const double time = s_ring_stats_dump_time.GetTimeSeconds();
+	for (u32 i = 0; i < NUM_RINGS; i++)
+	{
+		if (!GetRingCounters(static_cast<PerformanceMetrics::Ring>(i)))
+			continue;
+
+		const PerformanceMetrics::RingStats& stats = s_ring_stats[i];
+		fmt::print(s_ring_stats_dump_file.get(), "{:.3f},{},{},{:.0f},{},{:.2f},{:.2f},{:.2f}\n", time,
+			PerformanceMetrics::GetFrameNumber(), s_ring_names[i], stats.packets_per_second, stats.producer_stalls,
+			stats.producer_stall_percent, stats.consumer_idle_percent, stats.high_water_percent);
+	}
+}
+
 void PerformanceMetrics::Clear()
 {
 	Reset();
@@ -102,6 +202,11 @@ void PerformanceMetrics::Clear()
 
 	s_frame_time_history.fill(0.0f);
 	s_frame_time_history_pos = 0;
+
+	for (WaitHistogram& histogram : s_wait_histograms)
+		histogram.fill(0);
+	s_wait_spin_times.fill(0);
+	s_ring_stats = {};
 }
 
 void PerformanceMetrics::Reset()
@@ -128,6 +233,27 @@ void PerformanceMetrics::Reset()
 
 	for (GSSWThreadStats& stat : s_gs_sw_threads)
 		stat.last_cpu_time = stat.handle.GetCPUTime();
+
+	// Throw away any waits from before the reset.
+	for (u32 i = 0; i < NUM_THREAD_WAITS; i++)
+	{
+		WaitHistogram discard = {};
+		if (Threading::SpinPolicy* policy = GetWaitSpinPolicy(static_cast<ThreadWait>(i)))
+		{
+			policy->CollectHistogram(discard);
+			policy->CollectWaitTime();
+		}
+	}
+
+	for (u32 i = 0; i < NUM_RINGS; i++)
+	{
+		if (RingCounters* counters = GetRingCounters(static_cast<Ring>(i)))
+		{
+			s_last_ring_counters[i] = {counters->packets.load(std::memory_order_relaxed),
+				counters->stalls.load(std::memory_order_relaxed), counters->stall_ticks.load(std::memory_order_relaxed)};
+			counters->high_water.store(0, std::memory_order_relaxed);
+		}
+	}
 }
 
 void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_skipping_present)
@@ -229,6 +355,24 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 		thread.time = static_cast<double>(delta) * time_divider;
 	}
 
+	UpdateRingStats(time);
+	{
+		std::unique_lock lock(s_ring_stats_dump_mutex);
+		if (s_ring_stats_dump_file)
+			WriteRingStatsDump();
+	}
+
+	for (u32 i = 0; i < NUM_THREAD_WAITS; i++)
+	{
+		s_wait_histograms[i].fill(0);
+		s_wait_spin_times[i] = 0;
+		if (Threading::SpinPolicy* policy = GetWaitSpinPolicy(static_cast<ThreadWait>(i)))
+		{
+			policy->CollectHistogram(s_wait_histograms[i]);
+			s_wait_spin_times[i] = policy->GetSpinTime();
+		}
+	}
+
 	s_frames_since_last_update = 0;
 	s_unskipped_frames_since_last_update = 0;
 	s_presents_since_last_update = 0;
@@ -391,3 +535,55 @@ u32 PerformanceMetrics::GetFrameTimeHistoryPos()
 {
 	return s_frame_time_history_pos;
 }
+
+const PerformanceMetrics::WaitHistogram& PerformanceMetrics::GetWaitHistogram(ThreadWait wait)
+{
+	return s_wait_histograms[static_cast<u32>(wait)];
+}
+
+u32 PerformanceMetrics::GetWaitSpinTime(ThreadWait wait)
+{
+	return s_wait_spin_times[static_cast<u32>(wait)];
+}
+
+const PerformanceMetrics::RingStats& PerformanceMetrics::GetRingStats(Ring ring)
+{
+	return s_ring_stats[static_cast<u32>(ring)];
+}
+
+bool PerformanceMetrics::StartRingStatsDump(std::string path, Error* error)
+{
+	FileSystem::ManagedCFilePtr file = FileSystem::OpenManagedCFile(path.c_str(), "wb", error);
+	if (!file)
+	{
+		StopRingStatsDump();
+		return false;
+	}
+
+	std::fputs("time,frame,ring,packets_per_second,producer_stalls,producer_stall_percent,consumer_idle_percent,"
+			   "high_water_percent\n",
+		file.get());
+
+	std::unique_lock lock(s_ring_stats_dump_mutex);
+	s_ring_stats_dump_file = std::move(file);
+	s_ring_stats_dump_path = std::move(path);
+	s_ring_stats_dump_time.Reset();
+	return true;
+}
+
+void PerformanceMetrics::StopRingStatsDump()
+{
+	std::unique_lock lock(s_ring_stats_dump_mutex);
+	s_ring_stats_dump_file.reset();
+}
+
+bool PerformanceMetrics::IsDumpingRingStats()
+{
+	std::unique_lock lock(s_ring_stats_dump_mutex);
+	return static_cast<bool>(s_ring_stats_dump_file);
+}
+
+const std::string& PerformanceMetrics::GetRingStatsDumpPath()
+{
+	return s_ring_stats_dump_path;
+}
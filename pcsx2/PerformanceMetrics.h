@@ -4,8 +4,12 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <string>
 #include "common/Threading.h"
 
+class Error;
+
 namespace PerformanceMetrics
 {
 	enum class InternalFPSMethod
@@ -15,8 +19,65 @@ namespace PerformanceMetrics
 		DISPFBBlit
 	};
 
+	enum class ThreadWait
+	{
+		GSIdle,
+		EEWaitingOnGS,
+		VUIdle,
+		EEWaitingOnVU,
+		Count
+	};
+
+	enum class Ring
+	{
+		GS, ///< EE -> MTGS
+		VU, ///< EE -> MTVU
+		Count
+	};
+
+	/// Counters for a ring buffer between two threads. Each counter only has one writer, so they're bumped
+	/// without locked instructions, and PerformanceMetrics reads the totals once per update interval.
+	struct RingCounters
+	{
+		explicit RingCounters(u32 size_) : size(size_) {}
+
+		const u32 size; ///< Number of entries in the ring.
+		std::atomic<u64> packets{0}; ///< Packets processed, written by the consumer.
+		std::atomic<u64> stalls{0}; ///< Times the producer had to wait for space, written by the producer.
+		std::atomic<u64> stall_ticks{0}; ///< Time the producer spent waiting for space, written by the producer.
+		std::atomic<u32> high_water{0}; ///< Most ring entries in use since the last update, written by the producer.
+
+		__fi void AddPackets(u64 count)
+		{
+			packets.store(packets.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+		}
+
+		__fi void AddStall(u64 ticks)
+		{
+			stalls.store(stalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			stall_ticks.store(stall_ticks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+		}
+
+		__fi void UpdateHighWater(u32 used)
+		{
+			// Racing with the reset in PerformanceMetrics can only lose a reset, which is fine for stats.
+			if (used > high_water.load(std::memory_order_relaxed))
+				high_water.store(used, std::memory_order_relaxed);
+		}
+	};
+
+	struct RingStats
+	{
+		float packets_per_second;
+		u32 producer_stalls;
+		float producer_stall_percent; ///< Of wall time spent with the producer waiting for space.
+		float consumer_idle_percent; ///< Of wall time spent with the consumer waiting for work.
+		float high_water_percent; ///< Of the ring in use at the fullest point.
+	};
+
 	static constexpr u32 NUM_FRAME_TIME_SAMPLES = 150;
 	using FrameTimeHistory = std::array<float, NUM_FRAME_TIME_SAMPLES>;
+	using WaitHistogram = Threading::SpinPolicy::Histogram;
 
 	void Clear();
 	void Reset();
@@ -62,4 +123,17 @@ namespace PerformanceMetrics
 
 	const FrameTimeHistory& GetFrameTimeHistory();
 	u32 GetFrameTimeHistoryPos();
+
+	const RingStats& GetRingStats(Ring ring);
+
+	/// Appends the ring stats to a CSV file every update interval, until stopped or the VM shuts down.
+	bool StartRingStatsDump(std::string path, Error* error = nullptr);
+	void StopRingStatsDump();
+	bool IsDumpingRingStats();
+	const std::string& GetRingStatsDumpPath();
+
+	/// Number of waits in each bucket over the last update interval, see Threading::SpinPolicy for the bucket sizes.
+	const WaitHistogram& GetWaitHistogram(ThreadWait wait);
+	/// Time in nanoseconds the thread currently spins for before sleeping.
+	u32 GetWaitSpinTime(ThreadWait wait);
 } // namespace PerformanceMetrics
@@ -101,6 +101,49 @@ time_t MemoryCardFileEntryDateTime::ToTime() const
 #endif
 }
 
+MemoryCardPage* MemoryCardPageCache::Find(const u32 page)
+{
+	const u32 index = GetIndex(page);
+	return (index != InvalidIndex) ? &m_pages[index] : nullptr;
+}
+
+const MemoryCardPage* MemoryCardPageCache::Find(const u32 page) const
+{
+	const u32 index = GetIndex(page);
+	return (index != InvalidIndex) ? &m_pages[index] : nullptr;
+}
+
+MemoryCardPage& MemoryCardPageCache::Insert(const u32 page)
+{
+	if (page >= m_slots.size())
+		m_slots.resize(page + 1, 0);
+
+	if (m_slots[page] != 0)
+		return m_pages[m_slots[page] - 1];
+
+	m_pageNumbers.push_back(page);
+	m_pages.emplace_back();
+	m_slots[page] = static_cast<u32>(m_pages.size());
+	return m_pages.back();
+}
+
+void MemoryCardPageCache::Clear()
+{
+	// only reset the slots in use, the table stays allocated for the next round of writes
+	for (const u32 page : m_pageNumbers)
+		m_slots[page] = 0;
+
+	m_pageNumbers.clear();
+	m_pages.clear();
+}
+
+void MemoryCardPageCache::Swap(MemoryCardPageCache& other)
+{
+	m_slots.swap(other.m_slots);
+	m_pageNumbers.swap(other.m_pageNumbers);
+	m_pages.swap(other.m_pages);
+}
+
 FolderMemoryCard::FolderMemoryCard()
 	: m_framesUntilFlush(0)
 	, m_timeLastWritten(0)
@@ -111,15 +154,24 @@ FolderMemoryCard::FolderMemoryCard()
 {
 }
 
+FolderMemoryCard::~FolderMemoryCard()
+{
+	if (m_flushInProgress)
+		EndFlush();
+}
+
 void FolderMemoryCard::InitializeInternalData()
 {
+	if (m_flushInProgress)
+		EndFlush();
+
 	memset(&m_superBlock, 0xFF, sizeof(m_superBlock));
 	memset(&m_indirectFat, 0xFF, sizeof(m_indirectFat));
 	memset(&m_fat, 0xFF, sizeof(m_fat));
 	memset(&m_backupBlock1, 0xFF, sizeof(m_backupBlock1));
 	memset(&m_backupBlock2, 0xFF, sizeof(m_backupBlock2));
-	m_cache.clear();
-	m_oldDataCache.clear();
+	m_cache.Clear();
+	m_oldDataCache.Clear();
 	m_lastAccessedFile.CloseAll();
 	m_fileMetadataQuickAccess.clear();
 	m_timeLastWritten = 0;
@@ -204,9 +256,13 @@ void FolderMemoryCard::Close(bool flush)
 	{
 		Flush();
 	}
+	else if (m_flushInProgress)
+	{
+		EndFlush();
+	}
 
-	m_cache.clear();
-	m_oldDataCache.clear();
+	m_cache.Clear();
+	m_oldDataCache.Clear();
 	m_lastAccessedFile.CloseAll();
 	m_fileMetadataQuickAccess.clear();
 	m_isEnabled = false;
@@ -707,6 +763,8 @@ s32 FolderMemoryCard::IsPresent() const
 
 void FolderMemoryCard::GetSizeInfo(McdSizeInfo& outways) const
 {
+	std::unique_lock lock(m_flushMutex);
+
 	outways.SectorSize = PageSize;
 	outways.EraseBlockSizeInSectors = BlockSize / PageSize;
 	outways.McdSizeInSectors = GetSizeInClusters() * 2;
@@ -956,10 +1014,14 @@ s32 FolderMemoryCard::Read(u8* dest, u32 adr, int size)
 		const u32 dataLength = std::min((u32)size, (u32)(PageSize - offset));
 
 		// if we have a cache for this page, just load from that
-		auto it = m_cache.find(page);
-		if (it != m_cache.end())
+		// pages which are currently being flushed are still valid, and don't need to wait for the flush
+		if (const MemoryCardPage* cachePage = m_cache.Find(page))
 		{
-			memcpy(dest, &it->second.raw[offset], dataLength);
+			memcpy(dest, &cachePage->raw[offset], dataLength);
+		}
+		else if (const MemoryCardPage* flushPage = m_flushCache.Find(page))
+		{
+			memcpy(dest, &flushPage->raw[offset], dataLength);
 		}
 		else
 		{
@@ -998,6 +1060,9 @@ s32 FolderMemoryCard::Read(u8* dest, u32 adr, int size)
 
 void FolderMemoryCard::ReadDataWithoutCache(u8* const dest, const u32 adr, const u32 dataLength)
 {
+	// only blocks if a flush is writing to the internal data or files right now
+	std::unique_lock lock(m_flushMutex);
+
 	u8* src = GetSystemBlockPointer(adr);
 	if (src != nullptr)
 	{
@@ -1035,18 +1100,20 @@ s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 		const u32 dataLength = std::min((u32)size, PageSize - offset);
 
 		// if cache page has not yet been touched, fill it with the data from our memory card
-		auto it = m_cache.find(page);
-		MemoryCardPage* cachePage;
-		if (it == m_cache.end())
+		MemoryCardPage* cachePage = m_cache.Find(page);
+		if (!cachePage)
 		{
-			cachePage = &m_cache[page];
-			const u32 adrLoad = page * PageSizeRaw;
-			ReadDataWithoutCache(&cachePage->raw[0], adrLoad, PageSize);
-			memcpy(&m_oldDataCache[page].raw[0], &cachePage->raw[0], PageSize);
-		}
-		else
-		{
-			cachePage = &it->second;
+			cachePage = &m_cache.Insert(page);
+			if (const MemoryCardPage* flushPage = m_flushCache.Find(page))
+			{
+				memcpy(&cachePage->raw[0], &flushPage->raw[0], PageSize);
+			}
+			else
+			{
+				const u32 adrLoad = page * PageSizeRaw;
+				ReadDataWithoutCache(&cachePage->raw[0], adrLoad, PageSize);
+			}
+			memcpy(&m_oldDataCache.Insert(page).raw[0], &cachePage->raw[0], PageSize);
 		}
 
 		// then just write to the cache
@@ -1060,15 +1127,107 @@ s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 
 void FolderMemoryCard::NextFrame()
 {
+	if (m_flushInProgress && m_flushThreadDone.load(std::memory_order_acquire))
+	{
+		EndFlush();
+	}
+
 	if (m_framesUntilFlush > 0 && --m_framesUntilFlush == 0)
 	{
-		Flush();
+		if (m_flushInProgress)
+		{
+			// previous flush is still writing, try again next frame
+			m_framesUntilFlush = 1;
+		}
+		else
+		{
+			FlushAsync();
+		}
 	}
 }
 
 void FolderMemoryCard::Flush()
 {
-	if (m_cache.empty())
+	if (m_flushInProgress)
+	{
+		EndFlush();
+	}
+
+	if (m_cache.IsEmpty())
+	{
+		return;
+	}
+
+	BeginFlush();
+	{
+		std::unique_lock lock(m_flushMutex);
+		FlushCache();
+	}
+	EndFlush();
+}
+
+void FolderMemoryCard::FlushAsync()
+{
+	if (m_cache.IsEmpty())
+	{
+		return;
+	}
+
+	BeginFlush();
+	m_flushThreadDone.store(false, std::memory_order_relaxed);
+	m_flushThread = std::thread([this]() {
+		{
+			std::unique_lock lock(m_flushMutex);
+			FlushCache();
+		}
+		m_flushThreadDone.store(true, std::memory_order_release);
+	});
+}
+
+void FolderMemoryCard::BeginFlush()
+{
+	pxAssert(!m_flushInProgress);
+
+	m_flushCache.Swap(m_cache);
+	m_flushOldDataCache.Swap(m_oldDataCache);
+	m_cache.Clear();
+	m_oldDataCache.Clear();
+	m_flushedPages.assign(m_flushCache.GetCount(), false);
+	m_flushInProgress = true;
+}
+
+void FolderMemoryCard::EndFlush()
+{
+	if (m_flushThread.joinable())
+	{
+		m_flushThread.join();
+	}
+
+	// anything the flush couldn't write (eg. unformatted card) goes back to the cache, unless it's been written to since
+	for (u32 i = 0; i < m_flushCache.GetCount(); ++i)
+	{
+		const u32 page = m_flushCache.GetPageNumber(i);
+		if (m_flushedPages[i] || m_cache.Find(page))
+		{
+			continue;
+		}
+
+		memcpy(&m_cache.Insert(page).raw[0], &m_flushCache.GetPage(i).raw[0], PageSize);
+		if (const MemoryCardPage* oldPage = m_flushOldDataCache.Find(page))
+		{
+			memcpy(&m_oldDataCache.Insert(page).raw[0], &oldPage->raw[0], PageSize);
+		}
+	}
+
+	m_flushCache.Clear();
+	m_flushOldDataCache.Clear();
+	m_flushedPages.clear();
+	m_flushInProgress = false;
+}
+
+void FolderMemoryCard::FlushCache()
+{
+	if (m_flushCache.IsEmpty())
 	{
 		return;
 	}
@@ -1143,7 +1302,6 @@ void FolderMemoryCard::Flush()
 
 	m_lastAccessedFile.FlushAll();
 	m_lastAccessedFile.ClearMetadataWriteState();
-	m_oldDataCache.clear();
 
 	Console.WriteLn("FolderMcd: Done! Took %.2f ms.", timeFlushStart.GetTimeMilliseconds());
 
@@ -1154,11 +1312,11 @@ void FolderMemoryCard::Flush()
 
 bool FolderMemoryCard::FlushPage(const u32 page)
 {
-	auto it = m_cache.find(page);
-	if (it != m_cache.end())
+	const u32 index = m_flushCache.GetIndex(page);
+	if (index != MemoryCardPageCache::InvalidIndex && !m_flushedPages[index])
 	{
-		WriteWithoutCache(&it->second.raw[0], page * PageSizeRaw, PageSize);
-		m_cache.erase(it);
+		WriteWithoutCache(&m_flushCache.GetPage(index).raw[0], page * PageSizeRaw, PageSize);
+		m_flushedPages[index] = true;
 		return true;
 	}
 	return false;
@@ -1408,7 +1566,7 @@ void FolderMemoryCard::FlushDeletedFilesAndRemoveUnchangedDataFromCache(const st
 			}
 			else if (entry->IsFile())
 			{
-				// still exists and is a file, see if we can remove unchanged data from m_cache
+				// still exists and is a file, see if we can skip writing unchanged data
 				RemoveUnchangedDataFromCache(entry, newEntry);
 			}
 		}
@@ -1434,20 +1592,20 @@ void FolderMemoryCard::RemoveUnchangedDataFromCache(const MemoryCardFileEntry* c
 		for (int i = 0; i < 2; ++i)
 		{
 			const u32 page = (cluster + alloc_offset) * 2 + i;
-			auto newIt = m_cache.find(page);
-			if (newIt == m_cache.end())
+			const u32 index = m_flushCache.GetIndex(page);
+			if (index == MemoryCardPageCache::InvalidIndex || m_flushedPages[index])
 			{
 				continue;
 			}
-			auto oldIt = m_oldDataCache.find(page);
-			if (oldIt == m_oldDataCache.end())
+			const MemoryCardPage* oldPage = m_flushOldDataCache.Find(page);
+			if (!oldPage)
 			{
 				continue;
 			}
 
-			if (memcmp(&oldIt->second.raw[0], &newIt->second.raw[0], PageSize) == 0)
+			if (memcmp(&oldPage->raw[0], &m_flushCache.GetPage(index).raw[0], PageSize) == 0)
 			{
-				m_cache.erase(newIt);
+				m_flushedPages[index] = true;
 			}
 		}
 
@@ -1996,6 +2154,11 @@ std::FILE* FileAccessHelper::Open(const std::string_view folderName, MemoryCardF
 	}
 
 	std::FILE* file = FileSystem::OpenCFile(filename.c_str(), "r+b");
+	if (file)
+	{
+		// the default buffer is as small as 512 bytes on some platforms, so consecutive page writes would each hit the disk
+		std::setvbuf(file, nullptr, _IOFBF, FolderMemoryCard::FileWriteBufferSize);
+	}
 
 	std::string internalPath;
 	fileRef->GetInternalPath(&internalPath);
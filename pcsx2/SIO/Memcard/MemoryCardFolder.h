@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include "Config.h"
@@ -139,6 +142,41 @@ struct MemoryCardPage
 };
 #pragma pack(pop)
 
+// --------------------------------------------------------------------------------------
+//  MemoryCardPageCache
+// --------------------------------------------------------------------------------------
+// Cache of memory card pages, stored contiguously with a flat page number -> slot lookup table
+class MemoryCardPageCache
+{
+public:
+	static const u32 InvalidIndex = 0xFFFFFFFFu;
+
+	bool IsEmpty() const { return m_pages.empty(); }
+	u32 GetCount() const { return static_cast<u32>(m_pages.size()); }
+
+	// returns the slot of the given page, or InvalidIndex if it's not cached
+	u32 GetIndex(const u32 page) const { return (page < m_slots.size() && m_slots[page] != 0) ? (m_slots[page] - 1) : InvalidIndex; }
+	u32 GetPageNumber(const u32 index) const { return m_pageNumbers[index]; }
+	MemoryCardPage& GetPage(const u32 index) { return m_pages[index]; }
+	const MemoryCardPage& GetPage(const u32 index) const { return m_pages[index]; }
+
+	MemoryCardPage* Find(const u32 page);
+	const MemoryCardPage* Find(const u32 page) const;
+
+	// returns the existing page if it's already cached, otherwise adds an uninitialized one
+	// invalidates previously returned pointers
+	MemoryCardPage& Insert(const u32 page);
+
+	void Clear();
+
+	void Swap(MemoryCardPageCache& other);
+
+private:
+	std::vector<u32> m_slots; // slot + 1 for each page number, 0 if the page is not cached
+	std::vector<u32> m_pageNumbers;
+	std::vector<MemoryCardPage> m_pages;
+};
+
 struct MemoryCardFileEntryTreeNode
 {
 	MemoryCardFileEntry entry;
@@ -247,6 +285,9 @@ public:
 
 	static const int FramesAfterWriteUntilFlush = 2;
 
+	// size of the stdio buffer of each open file, so consecutive page writes to a file reach the file system together
+	static const int FileWriteBufferSize = BlockSize;
+
 protected:
 	union superBlockUnion
 	{
@@ -276,11 +317,24 @@ protected:
 	std::map<u32, MemoryCardFileMetadataReference> m_fileMetadataQuickAccess;
 
 	// holds a copy of modified pages of the memory card before they're flushed to the file system
-	std::map<u32, MemoryCardPage> m_cache;
+	MemoryCardPageCache m_cache;
 	// contains the state of how the data looked before the first write to it
 	// used to reduce the amount of disk I/O by not re-writing unchanged data that just happened to be
 	// touched in memory due to how actual physical memory cards have to erase and rewrite in blocks
-	std::map<u32, MemoryCardPage> m_oldDataCache;
+	MemoryCardPageCache m_oldDataCache;
+
+	// m_cache and m_oldDataCache as they were when the current flush started
+	// these are not modified while the flush thread runs, so they can be read without locking
+	MemoryCardPageCache m_flushCache;
+	MemoryCardPageCache m_flushOldDataCache;
+	// which pages of m_flushCache have been written (or found unchanged) by the flush, by slot
+	std::vector<bool> m_flushedPages;
+	// true while m_flushCache holds data, whether or not the flush thread is still running
+	bool m_flushInProgress = false;
+	std::atomic_bool m_flushThreadDone{false};
+	std::thread m_flushThread;
+	// held by the flush thread, protects the internal data, file metadata and m_lastAccessedFile
+	mutable std::mutex m_flushMutex;
 	// if > 0, the amount of frames until data is flushed to the file system
 	// reset to FramesAfterWriteUntilFlush on each write
 	int m_framesUntilFlush;
@@ -307,7 +361,7 @@ protected:
 
 public:
 	FolderMemoryCard();
-	virtual ~FolderMemoryCard() = default;
+	virtual ~FolderMemoryCard();
 
 	void Lock();
 	void Unlock();
@@ -466,9 +520,21 @@ protected:
 	bool WriteToFile(const u8* src, u32 adr, u32 dataLength);
 
 
-	// flush the whole cache to the internal data and/or host file system
+	// flush the whole cache to the internal data and/or host file system, waiting until it's done
 	void Flush();
 
+	// start flushing the cache on a background thread
+	void FlushAsync();
+
+	// moves the cache into m_flushCache, so new writes can continue while it's being flushed
+	void BeginFlush();
+
+	// writes m_flushCache to the internal data and/or host file system, m_flushMutex must be held
+	void FlushCache();
+
+	// waits for the flush thread, returns pages which weren't flushed to the cache and releases m_flushCache
+	void EndFlush();
+
 	// flush a single page of the cache to the internal data and/or host file system
 	bool FlushPage(const u32 page);
 
@@ -497,7 +563,7 @@ protected:
 	// - dirPath: Path to the current directory relative to the root of the memcard. Must be identical for both entries.
 	void FlushDeletedFilesAndRemoveUnchangedDataFromCache(const std::vector<MemoryCardFileEntryTreeNode>& oldFileEntries, const u32 newCluster, const u32 newFileCount, const std::string& dirPath);
 
-	// try and remove unchanged data from m_cache
+	// mark unchanged pages of m_flushCache as flushed, so they aren't written again
 	// oldEntry and newEntry should be equivalent entries found by FindEquivalent()
 	void RemoveUnchangedDataFromCache(const MemoryCardFileEntry* const oldEntry, const MemoryCardFileEntry* const newEntry);
 
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include "GS/GSVector.h"
 #include "Host/AudioStream.h"
 #include "SPU2/Debug.h"
 #include "SPU2/defs.h"
@@ -20,9 +21,11 @@
 
 #if MULTI_ISA_COMPILE_ONCE
 // decoded pcm data, used to cache the decoded data so that it needn't be decoded
-// multiple times.  Cache chunks are decoded when the mixer requests the blocks, and
-// invalided when DMA transfers and memory writes are performed.
-PcmCacheEntry pcm_cache_data[pcm_BlockCount];
+// multiple times.  Cache chunks are decoded when the mixer requests the blocks (or
+// prefetched ahead of that), and invalided when DMA transfers and memory writes are performed.
+PcmCacheEntry pcm_cache_data[pcm_CacheSets][pcm_CacheWays];
+u8 pcm_cache_state[pcm_BlockCount / 4];
+s16 pcm_voice_buffers[2][V_Core::NumVoices][pcm_DecodedSamplesPerBlock];
 
 int g_counter_cache_hits = 0;
 int g_counter_cache_misses = 0;
@@ -93,18 +96,114 @@ static void __forceinline IncrementNextA(V_Core& thiscore, uint voiceidx)
 	vc.NextA &= 0xFFFFF;
 }
 
+// Returns the entry holding block, valid or not, or nullptr if it isn't in the cache.
+static __forceinline PcmCacheEntry* PcmCacheFind(u32 block)
+{
+	for (PcmCacheEntry& entry : pcm_cache_data[block % pcm_CacheSets])
+	{
+		if (entry.Block == block)
+			return &entry;
+	}
+
+	return nullptr;
+}
+
+static bool PcmCacheEntryInUse(const PcmCacheEntry& entry)
+{
+	for (const V_Core& core : Cores)
+	{
+		for (const V_Voice& vc : core.Voices)
+		{
+			if (vc.SBuffer == entry.Sampledata)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+// Picks an entry to hold block, skipping entries which are used recently (the first time
+// around), and entries which a voice is still reading from. Returns nullptr if all are in use.
+static PcmCacheEntry* PcmCacheAllocate(u32 block)
+{
+	PcmCacheEntry* set = pcm_cache_data[block % pcm_CacheSets];
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (u32 way = 0; way < pcm_CacheWays; way++)
+		{
+			PcmCacheEntry& entry = set[way];
+			if (pass == 0 && (PcmCacheGetState(entry.Block) & PCM_BLOCK_REFERENCED))
+			{
+				PcmCacheClearState(entry.Block, PCM_BLOCK_REFERENCED);
+				continue;
+			}
+
+			if (PcmCacheEntryInUse(entry))
+				continue;
+
+			PcmCacheClearState(entry.Block, PCM_BLOCK_VALID | PCM_BLOCK_REFERENCED);
+			entry.Block = block;
+			return &entry;
+		}
+	}
+
+	return nullptr;
+}
+
+// Decodes the block a voice will move on to into the cache, while it's still in the middle of
+// the current one, so the decode doesn't land on the sample which crosses the block boundary.
+static __forceinline void PrefetchNextBlock(const V_Voice& vc)
+{
+	// The voice stops at the end of this block.
+	if ((vc.LoopFlags & XAFLAG_LOOP_END) && !(vc.LoopFlags & XAFLAG_LOOP))
+		return;
+
+	const u32 nextA = ((vc.LoopFlags & XAFLAG_LOOP_END) ? vc.LoopStartA : ((vc.NextA & 0xFFFF8) + pcm_WordsPerBlock)) & 0xFFFF8;
+	if (nextA < SPU2_DYN_MEMLINE)
+		return;
+
+	const u32 block = nextA / pcm_WordsPerBlock;
+	PcmCacheEntry* entry = PcmCacheFind(block);
+	if (entry)
+	{
+		// Already there, or another voice is reading it and we can't decode over it yet.
+		if (((PcmCacheGetState(block) & PCM_BLOCK_VALID) && vc.Prev1 == entry->Prev1 && vc.Prev2 == entry->Prev2) ||
+			PcmCacheEntryInUse(*entry))
+		{
+			return;
+		}
+	}
+	else
+	{
+		entry = PcmCacheAllocate(block);
+		if (!entry)
+			return;
+	}
+
+	entry->Prev1 = vc.Prev1;
+	entry->Prev2 = vc.Prev2;
+	PcmCacheSetState(block, PCM_BLOCK_VALID | PCM_BLOCK_REFERENCED);
+
+	s32 prev1 = vc.Prev1;
+	s32 prev2 = vc.Prev2;
+	XA_decode_block(entry->Sampledata, GetMemPtr(nextA), prev1, prev2);
+}
+
 static __forceinline void GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 {
 	V_Voice& vc(thiscore.Voices[voiceidx]);
 
 	if (vc.SBuffer == nullptr)
 	{
-		const int cacheIdx = (vc.NextA & 0xFFFF8) / pcm_WordsPerBlock;
-		PcmCacheEntry& cacheLine = pcm_cache_data[cacheIdx];
-		vc.SBuffer = cacheLine.Sampledata;
+		const u32 cacheIdx = (vc.NextA & 0xFFFF8) / pcm_WordsPerBlock;
+		PcmCacheEntry* cacheLine = (vc.NextA >= SPU2_DYN_MEMLINE) ? PcmCacheFind(cacheIdx) : nullptr;
 
-		if (cacheLine.Validated && vc.Prev1 == cacheLine.Prev1 && vc.Prev2 == cacheLine.Prev2)
+		if (cacheLine && (PcmCacheGetState(cacheIdx) & PCM_BLOCK_VALID) && vc.Prev1 == cacheLine->Prev1 && vc.Prev2 == cacheLine->Prev2)
 		{
+			vc.SBuffer = cacheLine->Sampledata;
+			PcmCacheSetState(cacheIdx, PCM_BLOCK_REFERENCED);
+
 			// Cached block!  Read from the cache directly.
 			// Make sure to propagate the prev1/prev2 ADPCM:
 
@@ -121,11 +220,22 @@ static __forceinline void GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 			// Only flag the cache if it's a non-dynamic memory range.
 			if (vc.NextA >= SPU2_DYN_MEMLINE)
 			{
-				cacheLine.Validated = true;
-				cacheLine.Prev1 = vc.Prev1;
-				cacheLine.Prev2 = vc.Prev2;
+				// Another voice may still be reading a copy decoded with different history.
+				if (!cacheLine)
+					cacheLine = PcmCacheAllocate(cacheIdx);
+				else if (PcmCacheEntryInUse(*cacheLine))
+					cacheLine = nullptr;
+
+				if (cacheLine)
+				{
+					cacheLine->Prev1 = vc.Prev1;
+					cacheLine->Prev2 = vc.Prev2;
+					PcmCacheSetState(cacheIdx, PCM_BLOCK_VALID | PCM_BLOCK_REFERENCED);
+				}
 			}
 
+			vc.SBuffer = cacheLine ? cacheLine->Sampledata : pcm_voice_buffers[thiscore.Index][voiceidx];
+
 			if (IsDevBuild)
 			{
 				if (vc.NextA < SPU2_DYN_MEMLINE)
@@ -146,6 +256,9 @@ static __forceinline void GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 	{
 		vc.DecodeFifo[(vc.DecPosWrite + i) % 32] = vc.SBuffer[sampleIdx + i];
 	}
+
+	if ((vc.NextA % pcm_WordsPerBlock) == 4)
+		PrefetchNextBlock(vc);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -420,21 +533,248 @@ static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
 	return voiceOut;
 }
 
+static_assert(VoiceMixLanes::NumVoices == V_Core::NumVoices);
+
+void MixVoiceLanes_reference(VoiceMixLanes& lanes, VoiceMixSet& dest)
+{
+	for (uint voiceidx = 0; voiceidx < VoiceMixLanes::NumVoices; ++voiceidx)
+	{
+		s32 Value = 0;
+		for (uint tap = 0; tap < 4; tap++)
+			Value += (lanes.Coef[tap][voiceidx] * lanes.Tap[tap][voiceidx]) >> 15;
+
+		Value = ApplyVolume(Value, lanes.Envelope[voiceidx]);
+		lanes.Out[voiceidx] = Value;
+
+		const s32 Left = ApplyVolume(Value, lanes.VolL[voiceidx]);
+		const s32 Right = ApplyVolume(Value, lanes.VolR[voiceidx]);
+
+		dest.Dry.Left += Left & lanes.DryL[voiceidx];
+		dest.Dry.Right += Right & lanes.DryR[voiceidx];
+		dest.Wet.Left += Left & lanes.WetL[voiceidx];
+		dest.Wet.Right += Right & lanes.WetR[voiceidx];
+	}
+}
+
+static __forceinline void AccumulateVoiceLanes(VoiceMixSet& dest, const GSVector4i& dry_l, const GSVector4i& dry_r,
+	const GSVector4i& wet_l, const GSVector4i& wet_r)
+{
+	const GSVector4i dry = dry_l.hadd32(dry_r);
+	const GSVector4i wet = wet_l.hadd32(wet_r);
+	const GSVector4i sum = dry.hadd32(wet);
+
+	dest.Dry.Left += sum.extract32<0>();
+	dest.Dry.Right += sum.extract32<1>();
+	dest.Wet.Left += sum.extract32<2>();
+	dest.Wet.Right += sum.extract32<3>();
+}
+
+#if _M_SSE >= 0x501
+static __forceinline void MixVoiceLanes_avx(VoiceMixLanes& lanes, VoiceMixSet& dest)
+{
+	GSVector8i dry_l = GSVector8i::zero();
+	GSVector8i dry_r = GSVector8i::zero();
+	GSVector8i wet_l = GSVector8i::zero();
+	GSVector8i wet_r = GSVector8i::zero();
+
+	for (uint voiceidx = 0; voiceidx < VoiceMixLanes::NumVoices; voiceidx += 8)
+	{
+		GSVector8i value = GSVector8i::zero();
+		for (uint tap = 0; tap < 4; tap++)
+		{
+			const GSVector8i coef = GSVector8i::load<true>(&lanes.Coef[tap][voiceidx]);
+			const GSVector8i sample = GSVector8i::load<true>(&lanes.Tap[tap][voiceidx]);
+			value = value.add32(coef.mul32l(sample).sra32<15>());
+		}
+
+		value = value.mul32l(GSVector8i::load<true>(&lanes.Envelope[voiceidx])).sra32<15>();
+		GSVector8i::store<true>(&lanes.Out[voiceidx], value);
+
+		const GSVector8i left = value.mul32l(GSVector8i::load<true>(&lanes.VolL[voiceidx])).sra32<15>();
+		const GSVector8i right = value.mul32l(GSVector8i::load<true>(&lanes.VolR[voiceidx])).sra32<15>();
+
+		dry_l = dry_l.add32(left & GSVector8i::load<true>(&lanes.DryL[voiceidx]));
+		dry_r = dry_r.add32(right & GSVector8i::load<true>(&lanes.DryR[voiceidx]));
+		wet_l = wet_l.add32(left & GSVector8i::load<true>(&lanes.WetL[voiceidx]));
+		wet_r = wet_r.add32(right & GSVector8i::load<true>(&lanes.WetR[voiceidx]));
+	}
+
+	AccumulateVoiceLanes(dest,
+		dry_l.extract<0>().add32(dry_l.extract<1>()), dry_r.extract<0>().add32(dry_r.extract<1>()),
+		wet_l.extract<0>().add32(wet_l.extract<1>()), wet_r.extract<0>().add32(wet_r.extract<1>()));
+}
+#endif
+
+static __forceinline void MixVoiceLanes_sse(VoiceMixLanes& lanes, VoiceMixSet& dest)
+{
+	GSVector4i dry_l = GSVector4i::zero();
+	GSVector4i dry_r = GSVector4i::zero();
+	GSVector4i wet_l = GSVector4i::zero();
+	GSVector4i wet_r = GSVector4i::zero();
+
+	for (uint voiceidx = 0; voiceidx < VoiceMixLanes::NumVoices; voiceidx += 4)
+	{
+		GSVector4i value = GSVector4i::zero();
+		for (uint tap = 0; tap < 4; tap++)
+		{
+			const GSVector4i coef = GSVector4i::load<true>(&lanes.Coef[tap][voiceidx]);
+			const GSVector4i sample = GSVector4i::load<true>(&lanes.Tap[tap][voiceidx]);
+			value = value.add32(coef.mul32l(sample).sra32<15>());
+		}
+
+		value = value.mul32l(GSVector4i::load<true>(&lanes.Envelope[voiceidx])).sra32<15>();
+		GSVector4i::store<true>(&lanes.Out[voiceidx], value);
+
+		const GSVector4i left = value.mul32l(GSVector4i::load<true>(&lanes.VolL[voiceidx])).sra32<15>();
+		const GSVector4i right = value.mul32l(GSVector4i::load<true>(&lanes.VolR[voiceidx])).sra32<15>();
+
+		dry_l = dry_l.add32(left & GSVector4i::load<true>(&lanes.DryL[voiceidx]));
+		dry_r = dry_r.add32(right & GSVector4i::load<true>(&lanes.DryR[voiceidx]));
+		wet_l = wet_l.add32(left & GSVector4i::load<true>(&lanes.WetL[voiceidx]));
+		wet_r = wet_r.add32(right & GSVector4i::load<true>(&lanes.WetR[voiceidx]));
+	}
+
+	AccumulateVoiceLanes(dest, dry_l, dry_r, wet_l, wet_r);
+}
+
+void MixVoiceLanes(VoiceMixLanes& lanes, VoiceMixSet& dest)
+{
+#if _M_SSE >= 0x501
+	MixVoiceLanes_avx(lanes, dest);
+#else
+	MixVoiceLanes_sse(lanes, dest);
+#endif
+}
+
+// Runs the parts of MixVoice() which come before interpolation, and fills in the voice's lane.
+// Returns false if the voice is stopped.
+static __forceinline bool PrepareVoiceLane(VoiceMixLanes& lanes, uint coreidx, uint voiceidx)
+{
+	V_Core& thiscore(Cores[coreidx]);
+	V_Voice& vc(thiscore.Voices[voiceidx]);
+
+	vc.Volume.Update();
+
+	DecodeSamples(coreidx, voiceidx);
+
+	lanes.VolL[voiceidx] = vc.Volume.Left.Value;
+	lanes.VolR[voiceidx] = vc.Volume.Right.Value;
+	lanes.DryL[voiceidx] = thiscore.VoiceGates[voiceidx].DryL;
+	lanes.DryR[voiceidx] = thiscore.VoiceGates[voiceidx].DryR;
+	lanes.WetL[voiceidx] = thiscore.VoiceGates[voiceidx].WetL;
+	lanes.WetR[voiceidx] = thiscore.VoiceGates[voiceidx].WetR;
+
+	if (vc.ADSR.Phase == V_ADSR::PHASE_STOPPED)
+	{
+		for (uint tap = 0; tap < 4; tap++)
+		{
+			lanes.Tap[tap][voiceidx] = 0;
+			lanes.Coef[tap][voiceidx] = 0;
+		}
+
+		lanes.Envelope[voiceidx] = 0;
+		return false;
+	}
+
+	if (vc.Noise)
+	{
+		lanes.Tap[0][voiceidx] = GetNoiseValues(thiscore);
+		lanes.Coef[0][voiceidx] = 0x8000;
+		for (uint tap = 1; tap < 4; tap++)
+		{
+			lanes.Tap[tap][voiceidx] = 0;
+			lanes.Coef[tap][voiceidx] = 0;
+		}
+	}
+	else
+	{
+		const int phase = (vc.SP & 0x0ff0) >> 4;
+		for (uint tap = 0; tap < 4; tap++)
+		{
+			lanes.Tap[tap][voiceidx] = vc.DecodeFifo[(vc.DecPosRead + tap) % 32];
+			lanes.Coef[tap][voiceidx] = interpTable[phase][tap];
+		}
+	}
+
+	// The envelope doesn't depend on the sample, so it can be advanced before interpolating.
+	CalculateADSR(thiscore, voiceidx);
+	lanes.Envelope[voiceidx] = vc.ADSR.Value;
+	return true;
+}
+
+// Runs the parts of MixVoice() which come after the voice output is known.
+static __forceinline void FinishVoiceLane(const VoiceMixLanes& lanes, uint coreidx, uint voiceidx, bool active)
+{
+	V_Core& thiscore(Cores[coreidx]);
+	V_Voice& vc(thiscore.Voices[voiceidx]);
+
+	const s32 Value = lanes.Out[voiceidx];
+	if (active)
+	{
+		vc.OutX = Value;
+
+		if (IsDevBuild)
+			DebugCores[coreidx].Voices[voiceidx].displayPeak = std::max(DebugCores[coreidx].Voices[voiceidx].displayPeak, (s32)vc.OutX);
+	}
+
+	UpdatePitch(coreidx, voiceidx);
+
+	ConsumeSamples(thiscore, voiceidx);
+
+	if (voiceidx == 1)
+		spu2M_WriteFast(((0 == coreidx) ? 0x400 : 0xc00) + OutPos, Value);
+	else if (voiceidx == 3)
+		spu2M_WriteFast(((0 == coreidx) ? 0x600 : 0xe00) + OutPos, Value);
+}
+
+// Voices 1 and 3 write their output back to SPU2 RAM as they're mixed. If a later voice is
+// reading from that area, it has to see this sample's write-back, so voices must be mixed
+// strictly one after another.
+static __forceinline bool VoicesReadWritebackArea(const V_Core& thiscore, uint coreidx)
+{
+	const u32 start = (0 == coreidx) ? 0x400 : 0xc00;
+
+	for (uint voiceidx = 2; voiceidx < V_Core::NumVoices; ++voiceidx)
+	{
+		if (((thiscore.Voices[voiceidx].NextA & 0xFFFF8) - start) < 0x400)
+			return true;
+	}
+
+	return false;
+}
+
 static __forceinline void MixCoreVoices(VoiceMixSet& dest, const uint coreidx)
 {
 	V_Core& thiscore(Cores[coreidx]);
 
-	for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
+	if (VoicesReadWritebackArea(thiscore, coreidx))
 	{
-		StereoOut32 VVal(MixVoice(coreidx, voiceidx));
+		for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
+		{
+			StereoOut32 VVal(MixVoice(coreidx, voiceidx));
+
+			// Note: Results from MixVoice are ranged at 16 bits.
 
-		// Note: Results from MixVoice are ranged at 16 bits.
+			dest.Dry.Left += VVal.Left & thiscore.VoiceGates[voiceidx].DryL;
+			dest.Dry.Right += VVal.Right & thiscore.VoiceGates[voiceidx].DryR;
+			dest.Wet.Left += VVal.Left & thiscore.VoiceGates[voiceidx].WetL;
+			dest.Wet.Right += VVal.Right & thiscore.VoiceGates[voiceidx].WetR;
+		}
 
-		dest.Dry.Left += VVal.Left & thiscore.VoiceGates[voiceidx].DryL;
-		dest.Dry.Right += VVal.Right & thiscore.VoiceGates[voiceidx].DryR;
-		dest.Wet.Left += VVal.Left & thiscore.VoiceGates[voiceidx].WetL;
-		dest.Wet.Right += VVal.Right & thiscore.VoiceGates[voiceidx].WetR;
+		return;
 	}
+
+	VoiceMixLanes lanes;
+	u32 active = 0;
+
+	for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
+		active |= static_cast<u32>(PrepareVoiceLane(lanes, coreidx, voiceidx)) << voiceidx;
+
+	MixVoiceLanes(lanes, dest);
+
+	// Pitch modulation uses the previous voice's output, so this has to run in voice order.
+	for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
+		FinishVoiceLane(lanes, coreidx, voiceidx, (active >> voiceidx) & 1);
 }
 
 static __forceinline StereoOut32 MixCore(const uint coreidx, const VoiceMixSet& inVoices, const StereoOut32& Input, const StereoOut32& Ext)
@@ -519,7 +859,7 @@ static __forceinline StereoOut32 MixCore(const uint coreidx, const VoiceMixSet&
 	return TD + ApplyVolume(RV, thiscore.FxVol);
 }
 
-void spu2Mix()
+static void spu2Mix()
 {
 	// Note: Playmode 4 is SPDIF, which overrides other inputs.
 	StereoOut32 InputData[2] =
@@ -613,4 +953,13 @@ void spu2Mix()
 	}
 }
 
+void spu2MixSamples(u32 count)
+{
+	for (u32 i = 0; i < count; i++)
+	{
+		Cycles++;
+		spu2Mix();
+	}
+}
+
 MULTI_ISA_UNSHARED_END
@@ -43,17 +43,46 @@ void V_Core::AnalyzeReverbPreset()
 	Console.WriteLn("----------------------------------------------------------");
 }
 
-__forceinline s32 V_Core::RevbGetIndexer(s32 offset)
+namespace
 {
-	u32 start = EffectsStartA & 0x3f'ffff;
-	u32 end = (EffectsEndA & 0x3f'ffff) | 0xffff;
+	// Maps reverb buffer offsets to SPU2 RAM addresses for the current sample. The position in
+	// the buffer is worked out once per sample, so offsets within the buffer (which is all of
+	// them, unless a game sets up something odd) only need an add and compare instead of a
+	// division each.
+	struct ReverbIndexer
+	{
+		u32 start;
+		u32 size;
+		u32 counter;
+		u32 pos;
 
-	u32 x = ((Cycles >> 1) + offset) % ((end - start) + 1);
+		__forceinline ReverbIndexer(const V_Core& core)
+		{
+			const u32 end = (core.EffectsEndA & 0x3f'ffff) | 0xffff;
+			start = core.EffectsStartA & 0x3f'ffff;
+			size = (end - start) + 1;
+			counter = Cycles >> 1;
+			pos = counter % size;
+		}
 
-	x += start;
+		__forceinline u32 operator()(u32 offset) const
+		{
+			u32 x;
+			if (offset < size)
+			{
+				x = pos + offset;
+				if (x >= size)
+					x -= size;
+			}
+			else
+			{
+				x = (counter + offset) % size;
+			}
 
-	return x & 0xf'ffff;
-}
+			return (x + start) & 0xf'ffff;
+		}
+	};
+} // namespace
 
 StereoOut32 V_Core::DoReverb(StereoOut32 Input)
 {
@@ -73,23 +102,25 @@ StereoOut32 V_Core::DoReverb(StereoOut32 Input)
 
 	// Calculate the read/write addresses we'll be needing for this session of reverb.
 
-	const u32 same_src = RevbGetIndexer(R ? Revb.SAME_R_SRC : Revb.SAME_L_SRC);
-	const u32 same_dst = RevbGetIndexer(R ? Revb.SAME_R_DST : Revb.SAME_L_DST);
-	const u32 same_prv = RevbGetIndexer(R ? Revb.SAME_R_DST - 1 : Revb.SAME_L_DST - 1);
+	const ReverbIndexer indexer(*this);
+
+	const u32 same_src = indexer(R ? Revb.SAME_R_SRC : Revb.SAME_L_SRC);
+	const u32 same_dst = indexer(R ? Revb.SAME_R_DST : Revb.SAME_L_DST);
+	const u32 same_prv = indexer(R ? Revb.SAME_R_DST - 1 : Revb.SAME_L_DST - 1);
 
-	const u32 diff_src = RevbGetIndexer(R ? Revb.DIFF_L_SRC : Revb.DIFF_R_SRC);
-	const u32 diff_dst = RevbGetIndexer(R ? Revb.DIFF_R_DST : Revb.DIFF_L_DST);
-	const u32 diff_prv = RevbGetIndexer(R ? Revb.DIFF_R_DST - 1 : Revb.DIFF_L_DST - 1);
+	const u32 diff_src = indexer(R ? Revb.DIFF_L_SRC : Revb.DIFF_R_SRC);
+	const u32 diff_dst = indexer(R ? Revb.DIFF_R_DST : Revb.DIFF_L_DST);
+	const u32 diff_prv = indexer(R ? Revb.DIFF_R_DST - 1 : Revb.DIFF_L_DST - 1);
 
-	const u32 comb1_src = RevbGetIndexer(R ? Revb.COMB1_R_SRC : Revb.COMB1_L_SRC);
-	const u32 comb2_src = RevbGetIndexer(R ? Revb.COMB2_R_SRC : Revb.COMB2_L_SRC);
-	const u32 comb3_src = RevbGetIndexer(R ? Revb.COMB3_R_SRC : Revb.COMB3_L_SRC);
-	const u32 comb4_src = RevbGetIndexer(R ? Revb.COMB4_R_SRC : Revb.COMB4_L_SRC);
+	const u32 comb1_src = indexer(R ? Revb.COMB1_R_SRC : Revb.COMB1_L_SRC);
+	const u32 comb2_src = indexer(R ? Revb.COMB2_R_SRC : Revb.COMB2_L_SRC);
+	const u32 comb3_src = indexer(R ? Revb.COMB3_R_SRC : Revb.COMB3_L_SRC);
+	const u32 comb4_src = indexer(R ? Revb.COMB4_R_SRC : Revb.COMB4_L_SRC);
 
-	const u32 apf1_src = RevbGetIndexer(R ? (Revb.APF1_R_DST - Revb.APF1_SIZE) : (Revb.APF1_L_DST - Revb.APF1_SIZE));
-	const u32 apf1_dst = RevbGetIndexer(R ? Revb.APF1_R_DST : Revb.APF1_L_DST);
-	const u32 apf2_src = RevbGetIndexer(R ? (Revb.APF2_R_DST - Revb.APF2_SIZE) : (Revb.APF2_L_DST - Revb.APF2_SIZE));
-	const u32 apf2_dst = RevbGetIndexer(R ? Revb.APF2_R_DST : Revb.APF2_L_DST);
+	const u32 apf1_src = indexer(R ? (Revb.APF1_R_DST - Revb.APF1_SIZE) : (Revb.APF1_L_DST - Revb.APF1_SIZE));
+	const u32 apf1_dst = indexer(R ? Revb.APF1_R_DST : Revb.APF1_L_DST);
+	const u32 apf2_src = indexer(R ? (Revb.APF2_R_DST - Revb.APF2_SIZE) : (Revb.APF2_L_DST - Revb.APF2_SIZE));
+	const u32 apf2_dst = indexer(R ? Revb.APF2_R_DST : Revb.APF2_L_DST);
 
 	// -----------------------------------------
 	//          Optimized IRQ Testing !
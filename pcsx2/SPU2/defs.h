@@ -63,12 +63,12 @@ struct StereoOut32
 	}
 };
 
-extern void (*spu2Mix)();
+extern void (*spu2MixSamples)(u32 count);
 extern s16* GetMemPtr(u32 addr);
 extern s16 spu2M_Read(u32 addr);
 extern void spu2M_Write(u32 addr, s16 value);
 extern void spu2M_Write(u32 addr, u16 value);
-MULTI_ISA_DEF(void spu2Mix();)
+MULTI_ISA_DEF(void spu2MixSamples(u32 count);)
 extern void spu2Output(StereoOut32 out);
 
 static __forceinline s16 SignExtend16(u16 v)
@@ -402,6 +402,36 @@ struct VoiceMixSet
 	}
 };
 
+// The per-sample state of one core's voices in structure-of-arrays form. The scalar parts of
+// voice processing (decoding, ADSR state, pitch) fill this in, then the interpolation, envelope,
+// volume and gating stages run across all voices at once.
+struct alignas(32) VoiceMixLanes
+{
+	static constexpr uint NumVoices = 24;
+
+	// Interpolation taps and gaussian coefficients. Noise voices put the noise value in the
+	// first tap with a coefficient of 0x8000, stopped voices have all coefficients set to zero.
+	s32 Tap[4][NumVoices];
+	s32 Coef[4][NumVoices];
+
+	s32 Envelope[NumVoices];
+	s32 VolL[NumVoices];
+	s32 VolR[NumVoices];
+
+	s32 DryL[NumVoices];
+	s32 DryR[NumVoices];
+	s32 WetL[NumVoices];
+	s32 WetR[NumVoices];
+
+	// Voice output after the envelope is applied, i.e. OutX.
+	s32 Out[NumVoices];
+};
+
+MULTI_ISA_DEF(
+	void MixVoiceLanes_reference(VoiceMixLanes& lanes, VoiceMixSet& dest);
+	void MixVoiceLanes(VoiceMixLanes& lanes, VoiceMixSet& dest);
+)
+
 struct V_Core
 {
 	static const uint NumVoices = 24;
@@ -502,7 +532,6 @@ struct V_Core
 	// --------------------------------------------------------------------------------------
 
 	StereoOut32 DoReverb(StereoOut32 Input);
-	s32 RevbGetIndexer(s32 offset);
 
 	StereoOut32 ReadInput();
 	StereoOut32 ReadInput_HiFi();
@@ -593,11 +622,11 @@ namespace SPU2Savestate
 // --------------------------------------------------------------------------------------
 //  ADPCM Decoder Cache
 // --------------------------------------------------------------------------------------
-//  the cache data size is determined by taking the number of adpcm blocks
-//  (2MB / 16) and multiplying it by the decoded block size (28 samples).
-//  Thus: pcm_cache_data = 7,340,032 bytes (ouch!)
-//  Expanded: 16 bytes expands to 56 bytes [3.5:1 ratio]
-//    Resulting in 2MB * 3.5.
+//  Decoded blocks are kept in a set-associative cache of pcm_CacheSets * pcm_CacheWays
+//  entries, instead of one entry for every block in SPU2 RAM (which would be 7MB, since
+//  every 16 byte block expands to 56 bytes). Only blocks which voices actually play end up
+//  in the cache, and a 2-bit-per-block state bitmap tracks whether a block's entry is valid,
+//  and whether it has been used recently (for second chance replacement).
 
 // The SPU2 has a dynamic memory range which is used for several internal operations, such as
 // registers, CORE 1/2 mixing, AutoDMAs, and some other fancy stuff.  We exclude this range
@@ -613,15 +642,47 @@ static constexpr int pcm_BlockCount = 0x100000 / pcm_WordsPerBlock;
 // 28 samples per decoded PCM block (as stored in our cache)
 static constexpr int pcm_DecodedSamplesPerBlock = 28;
 
+// 512 sets * 8 ways * 68 bytes = 272KB.
+static constexpr u32 pcm_CacheSets = 512;
+static constexpr u32 pcm_CacheWays = 8;
+
+// Per-block state bits.
+static constexpr u8 PCM_BLOCK_VALID = 1 << 0;
+static constexpr u8 PCM_BLOCK_REFERENCED = 1 << 1;
+
 struct PcmCacheEntry
 {
-	bool Validated;
-	s16 Sampledata[pcm_DecodedSamplesPerBlock];
+	u32 Block;
 	s32 Prev1;
 	s32 Prev2;
+	s16 Sampledata[pcm_DecodedSamplesPerBlock];
 };
 
-extern PcmCacheEntry pcm_cache_data[pcm_BlockCount];
+extern PcmCacheEntry pcm_cache_data[pcm_CacheSets][pcm_CacheWays];
+extern u8 pcm_cache_state[pcm_BlockCount / 4];
+
+// Blocks which can't be cached (dynamic memory, or every entry in the set is in use) are
+// decoded into the voice's own buffer instead.
+extern s16 pcm_voice_buffers[2][V_Core::NumVoices][pcm_DecodedSamplesPerBlock];
+
+static __forceinline u8 PcmCacheGetState(u32 block)
+{
+	return (pcm_cache_state[block >> 2] >> ((block & 3) * 2)) & 3;
+}
+
+static __forceinline void PcmCacheSetState(u32 block, u8 bits)
+{
+	pcm_cache_state[block >> 2] |= bits << ((block & 3) * 2);
+}
+
+static __forceinline void PcmCacheClearState(u32 block, u8 bits)
+{
+	pcm_cache_state[block >> 2] &= ~(bits << ((block & 3) * 2));
+}
+
+// Invalidates the cached data for blocks [first, last).
+extern void PcmCacheInvalidate(u32 first, u32 last);
+extern void PcmCacheReset();
 extern int g_counter_cache_hits;
 extern int g_counter_cache_misses;
 extern int g_counter_cache_ignores;
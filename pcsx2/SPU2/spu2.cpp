@@ -5,14 +5,20 @@
 #include "SPU2/defs.h"
 #include "SPU2/Debug.h"
 #include "SPU2/Dma.h"
+#include "SPU2/regs.h"
 #include "Host/AudioStream.h"
 #include "Host.h"
 #include "GS/GSCapture.h"
+#include "IopDma.h"
 #include "MTGS.h"
 #include "R3000A.h"
 #include "VMManager.h"
 
 #include "common/Error.h"
+#include "common/Threading.h"
+
+#include <array>
+#include <atomic>
 
 const StereoOut32 StereoOut32::Empty(0, 0);
 
@@ -22,6 +28,10 @@ namespace SPU2
 	static void UpdateSampleRate();
 	static float GetNominalRate();
 	static void InternalReset(bool psxmode);
+
+	static void StartMixerThread();
+	static void StopMixerThread();
+	static void MixerThreadEntryPoint();
 } // namespace SPU2
 
 u64 lClocks = 0;
@@ -38,6 +48,32 @@ static u32 s_fast_forward_volume = 0;
 
 float DCFilterIn[2], DCFilterOut[2];
 
+// Optional mixer thread. TimeUpdate() and SPU2write() put runs of samples and writes to mixer
+// parameters in a ring, which the thread replays in order. Reads and everything else which
+// touches SPU2 state wait for it to catch up first, so the result is the same as mixing on the
+// emulation thread.
+struct MixerCommand
+{
+	u32 samples; // Run of samples to mix, or zero for a register write.
+	u32 mem;
+	u16 value;
+};
+
+static constexpr u32 MIXER_RING_SIZE = 1024;
+
+static Threading::Thread s_mixer_thread;
+static Threading::WorkSema s_mixer_sema;
+static std::array<MixerCommand, MIXER_RING_SIZE> s_mixer_ring;
+alignas(64) static std::atomic<u32> s_mixer_ring_head{0};
+alignas(64) static std::atomic<u32> s_mixer_ring_tail{0};
+static std::atomic_bool s_mixer_shutdown{false};
+static std::atomic_bool s_mixer_irq_pending{false};
+static thread_local bool s_on_mixer_thread = false;
+
+// Samples queued since the thread was last caught up, and OutPos once they're mixed.
+static u32 s_mixer_queued_samples = 0;
+static u32 s_mixer_out_pos = 0;
+
 u32 SPU2::GetConsoleSampleRate()
 {
 	return s_psxmode ? PSX_SAMPLE_RATE : SAMPLE_RATE;
@@ -67,6 +103,8 @@ void SPU2writeDMA4Mem(u16* pMem, u32 size) // size now in 16bit units
 
 void SPU2interruptDMA4()
 {
+	SPU2::SyncMixerThread();
+
 	SPU2::FileLog("[%10d] SPU2 interruptDMA4\n", Cycles);
 	if (Cores[0].DmaMode)
 		Cores[0].Regs.STATX |= 0x80;
@@ -76,6 +114,8 @@ void SPU2interruptDMA4()
 
 void SPU2interruptDMA7()
 {
+	SPU2::SyncMixerThread();
+
 	SPU2::FileLog("[%10d] SPU2 interruptDMA7\n", Cycles);
 	if (Cores[1].DmaMode)
 		Cores[1].Regs.STATX |= 0x80;
@@ -102,6 +142,8 @@ void SPU2writeDMA7Mem(u16* pMem, u32 size)
 
 void SPU2::CreateOutputStream()
 {
+	WaitForMixerThread();
+
 	// Initialize volume and mute settings on new session.
 	if (!s_output_stream)
 	{
@@ -194,6 +236,8 @@ bool SPU2::IsOutputMuted()
 
 void SPU2::UpdateOutputVolume()
 {
+	WaitForMixerThread();
+
 	s_output_stream->SetOutputVolume(s_output_muted ?
 										 0 : (VMManager::GetTargetSpeed() == 1.0f ?
 										 	s_standard_volume : s_fast_forward_volume));
@@ -212,6 +256,8 @@ void SPU2::SaveOutputVolume()
 
 void SPU2::SetOutputPaused(bool paused)
 {
+	WaitForMixerThread();
+
 	s_output_stream->SetPaused(paused);
 }
 
@@ -227,7 +273,9 @@ bool SPU2::IsAudioCaptureActive()
 
 void SPU2::InternalReset(bool psxmode)
 {
-	spu2Mix = MULTI_ISA_SELECT(spu2Mix);
+	SyncMixerThread(false);
+
+	spu2MixSamples = MULTI_ISA_SELECT(spu2MixSamples);
 	ReverbDownsample = MULTI_ISA_SELECT(ReverbDownsample);
 	ReverbUpsample = MULTI_ISA_SELECT(ReverbUpsample);
 
@@ -261,6 +309,8 @@ void SPU2::OnTargetSpeedChanged()
 	if (!s_output_stream)
 		return;
 
+	WaitForMixerThread();
+
 	if (!s_output_stream->IsStretchEnabled())
 	{
 		s_output_stream->EmptyBuffer();
@@ -307,6 +357,9 @@ bool SPU2::Open()
 	WaveDump::Open();
 #endif
 
+	if (EmuConfig.SPU2.MixerThread)
+		StartMixerThread();
+
 	return true;
 }
 
@@ -314,6 +367,7 @@ void SPU2::Close()
 {
 	FileLog("[%10d] SPU2 Close\n", Cycles);
 
+	StopMixerThread();
 	s_output_stream.reset();
 
 #ifdef PCSX2_DEVBUILD
@@ -330,6 +384,127 @@ bool SPU2::IsRunningPSXMode()
 	return s_psxmode;
 }
 
+void SPU2::StartMixerThread()
+{
+	if (s_mixer_thread.Joinable())
+		return;
+
+	s_mixer_sema.Reset();
+	s_mixer_ring_head.store(0, std::memory_order_relaxed);
+	s_mixer_ring_tail.store(0, std::memory_order_relaxed);
+	s_mixer_queued_samples = 0;
+	s_mixer_shutdown.store(false, std::memory_order_release);
+	s_mixer_thread.Start(&SPU2::MixerThreadEntryPoint);
+}
+
+void SPU2::StopMixerThread()
+{
+	if (!s_mixer_thread.Joinable())
+		return;
+
+	s_mixer_sema.WaitForEmpty();
+	s_mixer_shutdown.store(true, std::memory_order_release);
+	s_mixer_sema.NotifyOfWork();
+	s_mixer_thread.Join();
+}
+
+void SPU2::MixerThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("SPU2 Mixer");
+	s_on_mixer_thread = true;
+
+	for (;;)
+	{
+		s_mixer_sema.WaitForWork();
+		if (s_mixer_shutdown.load(std::memory_order_acquire))
+			break;
+
+		const u32 head = s_mixer_ring_head.load(std::memory_order_acquire);
+		for (u32 tail = s_mixer_ring_tail.load(std::memory_order_relaxed); tail != head; tail++)
+		{
+			const MixerCommand& cmd = s_mixer_ring[tail % MIXER_RING_SIZE];
+			if (cmd.samples > 0)
+				MixSamples(cmd.samples);
+			else
+				SPU2_FastWrite(cmd.mem, cmd.value);
+
+			s_mixer_ring_tail.store(tail + 1, std::memory_order_release);
+		}
+	}
+
+	s_mixer_sema.Kill();
+}
+
+static void PushMixerCommand(const MixerCommand& cmd)
+{
+	const u32 head = s_mixer_ring_head.load(std::memory_order_relaxed);
+	if ((head - s_mixer_ring_tail.load(std::memory_order_acquire)) == MIXER_RING_SIZE)
+		s_mixer_sema.WaitForEmpty();
+
+	s_mixer_ring[head % MIXER_RING_SIZE] = cmd;
+	s_mixer_ring_head.store(head + 1, std::memory_order_release);
+	s_mixer_sema.NotifyOfWork();
+}
+
+bool SPU2::QueueMixerThreadSamples(u32 count)
+{
+	if (!s_mixer_thread.Joinable())
+		return false;
+
+	// If nothing has been queued since we last caught up, nothing is moving OutPos.
+	if (s_mixer_queued_samples == 0)
+		s_mixer_out_pos = OutPos;
+	s_mixer_queued_samples += count;
+	s_mixer_out_pos = (s_mixer_out_pos + count) & 0x1FF;
+
+	PushMixerCommand({count, 0, 0});
+	return true;
+}
+
+bool SPU2::QueueMixerThreadWrite(u32 mem, u16 value)
+{
+	if (!s_mixer_thread.Joinable())
+		return false;
+
+	PushMixerCommand({0, mem, value});
+	return true;
+}
+
+u32 SPU2::GetMixerThreadOutPos()
+{
+	return (s_mixer_queued_samples > 0) ? s_mixer_out_pos : OutPos;
+}
+
+void SPU2::WaitForMixerThread()
+{
+	if (!s_mixer_thread.Joinable())
+		return;
+
+	s_mixer_sema.WaitForEmpty();
+	s_mixer_queued_samples = 0;
+}
+
+void SPU2::SyncMixerThread(bool raise_irqs)
+{
+	WaitForMixerThread();
+
+	if (s_mixer_irq_pending.load(std::memory_order_relaxed))
+	{
+		s_mixer_irq_pending.store(false, std::memory_order_relaxed);
+		if (raise_irqs)
+			spu2Irq();
+	}
+}
+
+bool SPU2::DeferMixerThreadIrq()
+{
+	if (!s_on_mixer_thread)
+		return false;
+
+	s_mixer_irq_pending.store(true, std::memory_order_relaxed);
+	return true;
+}
+
 void SPU2::CheckForConfigChanges(const Pcsx2Config& old_config)
 {
 	const Pcsx2Config::SPU2Options& opts = EmuConfig.SPU2;
@@ -365,9 +540,18 @@ void SPU2::CheckForConfigChanges(const Pcsx2Config& old_config)
 	}
 	else if (opts.IsTimeStretchEnabled() != old_opts.IsTimeStretchEnabled())
 	{
+		WaitForMixerThread();
 		s_output_stream->SetStretchEnabled(opts.IsTimeStretchEnabled());
 	}
 
+	if (opts.MixerThread != old_opts.MixerThread)
+	{
+		if (opts.MixerThread)
+			StartMixerThread();
+		else
+			StopMixerThread();
+	}
+
 #ifdef PCSX2_DEVBUILD
 	// AccessLog controls file output.
 	if (opts.AccessLog != old_opts.AccessLog)
@@ -382,7 +566,22 @@ void SPU2::CheckForConfigChanges(const Pcsx2Config& old_config)
 
 void SPU2async()
 {
-	TimeUpdate(psxRegs.cycle);
+	// Nothing reads SPU2 state after this, so the samples can be mixed in the background.
+	TimeUpdate(psxRegs.cycle, true);
+}
+
+// Registers which only feed the mixer: voice parameters and addresses, PMON/NON/VMIX/MMIX, IRQA,
+// KON/KOFF, the reverb work area, ENDX and the volumes. Writing them can't have any effect outside
+// of the SPU2, so the mixer thread can apply them in order with the samples around them.
+static bool IsMixerRegister(u32 mem)
+{
+	mem &= 0x7ff;
+	if (mem >= 0x760)
+		return (mem < 0x7b0);
+
+	const u32 omem = mem & 0x3ff;
+	return (omem < REG_C_ATTR) || (omem >= REG_A_IRQA && omem < REG_A_TSA) ||
+		   (omem >= REG_VA_SSA && omem < REG_P_STATX);
 }
 
 u16 SPU2read(u32 rmem)
@@ -400,6 +599,8 @@ u16 SPU2read(u32 rmem)
 
 	if (omem == 0x1f9001AC)
 	{
+		SPU2::SyncMixerThread();
+
 		Cores[core].ActiveTSA = Cores[core].TSA;
 		for (int i = 0; i < 2; i++)
 		{
@@ -443,6 +644,18 @@ void SPU2write(u32 rmem, u16 value)
 	// If the SPU2 isn't in in sync with the IOP, samples can end up playing at rather
 	// incorrect pitches and loop lengths.
 
+	if (rmem >> 16 != 0x1f80 && IsMixerRegister(rmem))
+	{
+		TimeUpdate(psxRegs.cycle, true);
+
+#ifdef PCSX2_DEVBUILD
+		SPU2::WriteRegLog("write", rmem, value);
+#endif
+		if (!SPU2::QueueMixerThreadWrite(rmem, value))
+			SPU2_FastWrite(rmem, value);
+		return;
+	}
+
 	TimeUpdate(psxRegs.cycle);
 
 	if (rmem >> 16 == 0x1f80)
@@ -473,6 +686,10 @@ s32 SPU2freeze(FreezeAction mode, freezeData* data)
 
 	pxAssume(mode == FreezeAction::Load || mode == FreezeAction::Save);
 
+	// IRQs flagged by the mixer thread belong to the state being saved, but not to the one being
+	// replaced by a load.
+	SPU2::SyncMixerThread(mode == FreezeAction::Save);
+
 	if (data->data == nullptr)
 	{
 		printf("SPU2 savestate null pointer!\n");
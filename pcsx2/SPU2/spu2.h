@@ -63,6 +63,29 @@ u32 GetConsoleSampleRate();
 /// Tells SPU2 to forward audio packets to GSCapture.
 void SetAudioCaptureActive(bool active);
 bool IsAudioCaptureActive();
+
+/// Hands a run of samples to the mixer thread. Returns false if the thread isn't running,
+/// in which case the caller has to mix them itself.
+bool QueueMixerThreadSamples(u32 count);
+
+/// Hands a register write to the mixer thread, which applies it after the samples queued
+/// before it. Returns false if the thread isn't running.
+bool QueueMixerThreadWrite(u32 mem, u16 value);
+
+/// Returns what OutPos will be once everything queued so far has been mixed.
+u32 GetMixerThreadOutPos();
+
+/// Waits until the mixer thread has processed everything queued so far. Must be called before
+/// any SPU2 state is accessed from outside of the mixer.
+void WaitForMixerThread();
+
+/// Waits for the mixer thread, then raises the IRQs it flagged in the meantime. The emulation
+/// uses this instead of WaitForMixerThread(), so IRQs are always raised at the same point.
+void SyncMixerThread(bool raise_irqs = true);
+
+/// Returns true if called on the mixer thread, in which case the IRQ is left for the next
+/// SyncMixerThread() to raise.
+bool DeferMixerThreadIrq();
 } // namespace SPU2
 
 void SPU2write(u32 mem, u16 value);
@@ -81,6 +104,7 @@ void SPU2writeDMA7Mem(u16* pMem, u32 size);
 extern u64 lClocks;
 
 extern void CounterUpdate(u32 DMAICounter);
-extern void TimeUpdate(u32 cClocks);
+extern void TimeUpdate(u32 cClocks, bool allow_mixer_thread = false);
+extern void MixSamples(u32 count);
 extern void SPU2_FastWrite(u32 rmem, u16 value);
 
@@ -18,7 +18,8 @@ namespace SPU2Savestate
 
 	static void wipe_the_cache()
 	{
-		memset(pcm_cache_data, 0, pcm_BlockCount * sizeof(PcmCacheEntry));
+		PcmCacheReset();
+		memset(pcm_voice_buffers, 0, sizeof(pcm_voice_buffers));
 	}
 } // namespace SPU2Savestate
 
@@ -145,16 +146,13 @@ s32 SPU2Savestate::ThawIt(DataBlock& spud)
 
 		wipe_the_cache();
 
-		// Go through the V_Voice structs and recalculate SBuffer pointer from
-		// the NextA setting.
+		// The decoded data isn't saved, so voices which were part way through a block
+		// carry on with the (now wiped) buffer, as they always have.
 
 		for (int c = 0; c < 2; c++)
 		{
 			for (int v = 0; v < 24; v++)
-			{
-				const int cacheIdx = Cores[c].Voices[v].NextA / pcm_WordsPerBlock;
-				Cores[c].Voices[v].SBuffer = pcm_cache_data[cacheIdx].Sampledata;
-			}
+				Cores[c].Voices[v].SBuffer = pcm_voice_buffers[c][v];
 		}
 	}
 	return 0;
@@ -37,7 +37,7 @@ StereoOut32 (*ReverbUpsample)(V_Core& core);
 s32 (*ReverbDownsample)(V_Core& core, bool right);
 
 // Function pointer for multi-isa mixer 
-void (*spu2Mix)();
+void (*spu2MixSamples)(u32 count);
 
 static bool psxmode = false;
 
@@ -47,7 +47,10 @@ void SetIrqCall(int core)
 	if (!(Spdif.Info & (4 << core)) && Cores[core].IRQEnable)
 	{
 		Spdif.Info |= (4 << core);
-		spu2Irq();
+
+		// The mixer thread can't touch the IOP, the emulation thread raises it when it catches up.
+		if (!SPU2::DeferMixerThreadIrq())
+			spu2Irq();
 	}
 }
 
@@ -73,6 +76,24 @@ __forceinline s16 spu2M_Read(u32 addr)
 	return *GetMemPtr(addr & 0xfffff);
 }
 
+void PcmCacheInvalidate(u32 first, u32 last)
+{
+	for (u32 block = first; block < last; block++)
+		PcmCacheClearState(block, PCM_BLOCK_VALID);
+}
+
+void PcmCacheReset()
+{
+	std::memset(pcm_cache_state, 0, sizeof(pcm_cache_state));
+
+	// Block 0 is below SPU2_DYN_MEMLINE, so it'll never be looked up.
+	for (auto& set : pcm_cache_data)
+	{
+		for (PcmCacheEntry& entry : set)
+			entry.Block = 0;
+	}
+}
+
 // writes a signed value to the SPU2 ram
 // Invalidates the ADPCM cache in the process.
 __forceinline void spu2M_Write(u32 addr, s16 value)
@@ -84,7 +105,7 @@ __forceinline void spu2M_Write(u32 addr, s16 value)
 	if (addr >= SPU2_DYN_MEMLINE)
 	{
 		const int cacheIdx = addr / pcm_WordsPerBlock;
-		pcm_cache_data[cacheIdx].Validated = false;
+		PcmCacheClearState(cacheIdx, PCM_BLOCK_VALID);
 
 		if (SPU2::MsgToConsole() && SPU2::MsgCache())
 			SPU2::ConLog("* SPU2: PcmCache Block Clear at 0x%x (cacheIdx=0x%x)\n", addr, cacheIdx);
@@ -314,8 +335,67 @@ __forceinline void CheckDMAProgress(int cid)
 static constexpr uint TickInterval = 768;
 static constexpr int SanityInterval = 4800;
 
-__forceinline void TimeUpdate(u32 cClocks)
+// Samples can only be mixed on the mixer thread if they can't touch anything outside of the
+// SPU2. IRQs are fine, they're raised later, but DMAs and the AutoDMA MADR updates aren't, and
+// AutoDMA refills read IOP memory, so the samples which refill have to be mixed here.
+static bool CanUseMixerThread(u32 samples)
 {
+	const u32 out_pos = SPU2::GetMixerThreadOutPos();
+
+	for (const V_Core& core : Cores)
+	{
+		if (core.DMAICounter > 0 || core.InputDataTransferred)
+			return false;
+
+		if (core.InputDataLeft >= 0x100)
+		{
+			// ReadInput() refills every 0x80 reads, which is every 0x40 samples when it reads two at once.
+			const bool doubled = (core.Index == 0) ? (PlayMode == 2) : ((PlayMode & 8) != 0);
+			const u32 interval = doubled ? 0x40 : 0x80;
+			if (((interval - (out_pos % interval)) % interval) < samples)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static bool IsAnyIrqEnabled()
+{
+	return Cores[0].IRQEnable || Cores[1].IRQEnable;
+}
+
+// Register writes and DMA transfers only ever land between runs, either after TimeUpdate() or in
+// order on the mixer thread, so nothing can change the SPU2 state while we're mixing. Pending key
+// on/offs get applied before the first sample, and the rest of the run is mixed in one go.
+void MixSamples(u32 count)
+{
+	for (int c = 0; c < 2; c++)
+	{
+		if (Cores[c].KeyOff)
+		{
+			StopVoices(c, Cores[c].KeyOff);
+			Cores[c].KeyOff = 0;
+		}
+
+		if (Cores[c].KeyOn)
+		{
+			StartVoices(c, Cores[c].KeyOn);
+			Cores[c].KeyOn = 0;
+		}
+	}
+
+	spu2MixSamples(count);
+}
+
+__forceinline void TimeUpdate(u32 cClocks, bool allow_mixer_thread)
+{
+	// The caller is about to look at SPU2 state, so anything still being mixed has to finish.
+	// While IRQs are enabled we also catch up on every update, so the ones flagged by the mixer
+	// thread are raised exactly one update late, not whenever the thread happens to finish.
+	if (!allow_mixer_thread || IsAnyIrqEnabled())
+		SPU2::SyncMixerThread();
+
 	u32 dClocks = cClocks - lClocks;
 
 	// Sanity Checks:
@@ -338,28 +418,17 @@ __forceinline void TimeUpdate(u32 cClocks)
 	}
 
 	//Update Mixing Progress
-	while (dClocks >= TickInterval)
+	const u32 samples = dClocks / TickInterval;
+	if (samples > 0)
 	{
-		dClocks -= TickInterval;
-		lClocks += TickInterval;
-		Cycles++;
+		dClocks -= samples * TickInterval;
+		lClocks += samples * TickInterval;
 
-		for(int c = 0; c < 2; c++)
+		if (!allow_mixer_thread || !CanUseMixerThread(samples) || !SPU2::QueueMixerThreadSamples(samples))
 		{
-			if (Cores[c].KeyOff)
-			{
-				StopVoices(c, Cores[c].KeyOff);
-				Cores[c].KeyOff = 0;
-			}
-
-			if (Cores[c].KeyOn)
-			{
-				StartVoices(c, Cores[c].KeyOn);
-				Cores[c].KeyOn = 0;
-			}
+			SPU2::SyncMixerThread();
+			MixSamples(samples);
 		}
-
-		spu2Mix();
 	}
 
 	CheckDMAProgress(0);
@@ -14,6 +14,7 @@
 #include "GS.h"
 #include "GS/GS.h"
 #include "Host.h"
+#include "IPU/IPU.h"
 #include "MTGS.h"
 #include "MTVU.h"
 #include "Patch.h"
@@ -176,6 +177,9 @@ bool SaveStateBase::FreezeInternals(Error* error)
 	if (THREAD_VU1)
 		Console.Warning("MTVU speedhack is enabled, saved states may not be stable");
 
+	// Anything the IPU thread has queued up for the EE has to be in the state we save.
+	ipuThreadSync();
+
 	if (!vmFreeze())
 		return false;
 
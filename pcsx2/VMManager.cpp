@@ -8,6 +8,7 @@
 #include "Counters.h"
 #include "DEV9/DEV9.h"
 #include "DebugTools/DebugInterface.h"
+#include "DebugTools/GuestProfiler.h"
 #include "DebugTools/SymbolImporter.h"
 #include "Elfheader.h"
 #include "FW.h"
@@ -18,6 +19,7 @@
 #include "GameList.h"
 #include "Host.h"
 #include "INISettingsInterface.h"
+#include "IPU/IPU.h"
 #include "ImGui/FullscreenUI.h"
 #include "ImGui/ImGuiOverlays.h"
 #include "Input/InputManager.h"
@@ -143,6 +145,7 @@ namespace VMManager
 	static void SetHardwareDependentDefaultSettings(SettingsInterface& si);
 	static void EnsureCPUInfoInitialized();
 	static void SetEmuThreadAffinities();
+	static void ApplyThreadWaitMode();
 
 	static void InitializeDiscordPresence();
 	static void ShutdownDiscordPresence();
@@ -1146,6 +1149,9 @@ void VMManager::UpdateDiscDetails(bool booting)
 	UpdateGameSettingsLayer();
 	ApplySettings();
 
+	// Wait times are game-dependent too, start learning them again.
+	ApplyThreadWaitMode();
+
 	// Patches are game-dependent, thus should get applied after game settings ia loaded.
 	Patch::ReloadPatches(s_disc_serial, HasBootedELF() ? s_current_crc : 0, true, true, false, false);
 
@@ -1633,6 +1639,7 @@ VMBootResult VMManager::Initialize(const VMBootParameters& boot_params, Error* e
 	UpdateInhibitScreensaver(EmuConfig.InhibitScreensaver);
 
 	SetEmuThreadAffinities();
+	ApplyThreadWaitMode();
 
 	// do we want to load state?
 	if (!GSDumpReplayer::IsReplayingDump() && !state_to_load.empty())
@@ -1660,6 +1667,7 @@ void VMManager::Shutdown(bool save_resume_state)
 	if (THREAD_VU1)
 		vu1Thread.WaitVU();
 	MTGS::WaitGS();
+	ipuThreadShutdown();
 
 	if (!GSDumpReplayer::IsReplayingDump() && save_resume_state)
 	{
@@ -1677,6 +1685,11 @@ void VMManager::Shutdown(bool save_resume_state)
 	if (g_InputRecording.isActive())
 		g_InputRecording.stop();
 
+	// write out any in-progress guest profile while the symbol tables are still populated
+	if (GuestProfiler::IsActive())
+		GuestProfiler::Stop();
+	PerformanceMetrics::StopRingStatsDump();
+
 	SaveSessionTime(s_disc_serial);
 	s_elf_override = {};
 	ClearELFInfo();
@@ -2905,6 +2918,8 @@ void VMManager::Internal::VSyncOnCPUThread()
 
 	Patch::ApplyVsyncPatches();
 
+	PINEServer::VSync();
+
 	// Frame advance must be done *before* pumping messages, because otherwise
 	// we'll immediately reduce the counter we just set.
 	if (s_frame_advance_count > 0)
@@ -3103,6 +3118,9 @@ void VMManager::CheckForMiscConfigChanges(const Pcsx2Config& old_config)
 	{
 		SetEmuThreadAffinities();
 	}
+
+	if (HasValidVM() && EmuConfig.ThreadWaitMode != old_config.ThreadWaitMode)
+		ApplyThreadWaitMode();
 }
 
 void VMManager::CheckForConfigChanges(const Pcsx2Config& old_config)
@@ -3667,6 +3685,18 @@ void VMManager::EnsureCPUInfoInitialized()
 	std::call_once(s_processor_list_initialized, InitializeProcessorList);
 }
 
+void VMManager::ApplyThreadWaitMode()
+{
+	// Also forgets anything the adaptive policy learned, so call it when the game changes.
+	const Threading::SpinPolicy::Mode mode = static_cast<Threading::SpinPolicy::Mode>(EmuConfig.ThreadWaitMode);
+	for (Threading::SpinPolicy* policy : {&MTGS::GetIdleSpinPolicy(), &MTGS::GetWaitSpinPolicy(),
+			 &vu1Thread.idleSpinPolicy, &vu1Thread.waitSpinPolicy})
+	{
+		policy->SetMode(mode);
+		policy->Reset();
+	}
+}
+
 void VMManager::SetEmuThreadAffinities()
 {
 	const bool new_pin_enable = (GetState() != VMState::Shutdown && EmuConfig.EnableThreadPinning);
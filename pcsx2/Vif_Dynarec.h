@@ -17,6 +17,44 @@ extern void VifUnpackSSE_Init();
 
 _vifT extern void dVifUnpack(const u8* data, bool isFill);
 
+// Block cache statistics, indexed by unpack shape [usn:mask:upk] (nVifBlock::upkType).
+struct nVifStats
+{
+	u64 hits[64];
+	u64 misses[64];      // Blocks compiled on demand
+	u64 precompiled[64]; // Blocks compiled ahead of time by dVifReset
+
+	void reset() { std::memset(this, 0, sizeof(*this)); }
+	void log(int idx) const;
+};
+
+// The most common unpack shapes by far are the plain V4-32, V4-16 and V3-32 vertex streams
+// with masking off and CL == WL. VIF1 compiles these ahead of time on reset, so the first
+// frames after boot or a cache flush don't stall on translation.
+static constexpr u8 nVifPrecompileShapes[] = {0xc, 0xd, 0x8}; // V4-32, V4-16, V3-32
+static constexpr u8 nVifPrecompileCycle = 4; // CL = WL = 4
+static constexpr u32 nVifPrecompileMaxNum = 32;
+
+// Builds the hash bucket key of an unpack.
+// Performance note: initial code was using u8/u16 field of the struct
+// directly. However reading back the data (as u32) in HashBucket.find
+// leads to various memory stalls. So it is way faster to manually build the data
+// in u32 (aka x86 register).
+//
+// Warning the order of data in hash_key/key0/key1 depends on the nVifBlock struct
+static __fi void dVifSetBlockKey(nVifBlock& block, u8 upkType, u8 num, u32 mask, u8 cl, u8 wl, u8 aligned, u8 mode)
+{
+	const u32 hash_key = static_cast<u32>(upkType) << 8 | num;
+
+	u32 key1 = (static_cast<u32>(wl) << 24) | (static_cast<u32>(cl) << 16) | (static_cast<u32>(aligned) << 8) | static_cast<u32>(mode);
+	if ((upkType & 0xf) != 9)
+		key1 &= 0xFFFF01FF;
+
+	block.hash_key = hash_key;
+	block.key0 = mask;
+	block.key1 = key1;
+}
+
 struct nVifStruct
 {
 	// Buffer for partial transfers (should always be first to ensure alignment)
@@ -32,6 +70,7 @@ struct nVifStruct
 	u8*                     recEndPtr;
 
 	HashBucket              vifBlocks;   // Vif Blocks
+	nVifStats               stats;
 
 
 	nVifStruct() = default;
@@ -321,6 +321,25 @@ void releaseNewVif(int idx)
 {
 }
 
+void nVifStats::log(int idx) const
+{
+	static constexpr const char* upkNames[16] = {
+		"S-32", "S-16", "S-8", "S-??", "V2-32", "V2-16", "V2-8", "V2-??",
+		"V3-32", "V3-16", "V3-8", "V3-??", "V4-32", "V4-16", "V4-8", "V4-5"};
+
+	for (u32 upkType = 0; upkType < std::size(hits); upkType++)
+	{
+		if (!hits[upkType] && !misses[upkType] && !precompiled[upkType])
+			continue;
+
+		const u64 lookups = hits[upkType] + misses[upkType];
+		DevCon.WriteLnFmt("nVif{}: {:<5} usn={} mask={}: {} hits, {} misses ({:.2f}% hit rate), {} precompiled", idx,
+			upkNames[upkType & 0xf], (upkType >> 5) & 1, (upkType >> 4) & 1, hits[upkType], misses[upkType],
+			lookups ? (static_cast<double>(hits[upkType]) * 100.0 / static_cast<double>(lookups)) : 0.0,
+			precompiled[upkType]);
+	}
+}
+
 static __fi u8* getVUptr(uint idx, int offset)
 {
 	return (u8*)(vuRegs[idx].Mem + (offset & (idx ? 0x3ff0 : 0xff0)));
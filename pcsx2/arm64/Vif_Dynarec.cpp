@@ -170,14 +170,22 @@ static void maskedVecWrite(const a64::VRegister& reg, const a64::MemOperand& add
 	}
 }
 
+_vifT static void dVifPrecompile();
+
 void dVifReset(int idx)
 {
+	nVif[idx].stats.log(idx);
+	nVif[idx].stats.reset();
 	nVif[idx].vifBlocks.reset();
 
 	const size_t offset = idx ? HostMemoryMap::VIF1recOffset : HostMemoryMap::VIF0recOffset;
 	const size_t size = idx ? HostMemoryMap::VIF1recSize : HostMemoryMap::VIF0recSize;
 	nVif[idx].recWritePtr = SysMemory::GetCodePtr(offset);
 	nVif[idx].recEndPtr = nVif[idx].recWritePtr + (size - _256kb);
+
+	// VIF0 unpacks are rare enough that compiling them on demand is fine.
+	if (idx)
+		dVifPrecompile<1>();
 }
 
 void dVifRelease(int idx)
@@ -498,6 +506,29 @@ _vifT __fi nVifBlock* dVifCompile(nVifBlock& block, bool isFill)
 	return &block;
 }
 
+_vifT static void dVifPrecompile()
+{
+	nVifStruct& v = nVif[idx];
+
+	for (const u8 upkType : nVifPrecompileShapes)
+	{
+		// start_aligned only keeps its low bit in the key for these shapes.
+		for (u8 aligned = 0; aligned < 2; aligned++)
+		{
+			for (u32 num = 1; num <= nVifPrecompileMaxNum; num++)
+			{
+				nVifBlock block;
+				dVifSetBlockKey(block, upkType, static_cast<u8>(num), 0, nVifPrecompileCycle, nVifPrecompileCycle, aligned, 0);
+				if (v.vifBlocks.find(block))
+					continue;
+
+				dVifCompile<idx>(block, false);
+				v.stats.precompiled[upkType]++;
+			}
+		}
+	}
+}
+
 _vifT __fi void dVifUnpack(const u8* data, bool isFill)
 {
 	nVifStruct& v = nVif[idx];
@@ -509,25 +540,10 @@ _vifT __fi void dVifUnpack(const u8* data, bool isFill)
 
 	nVifBlock block;
 
-	// Performance note: initial code was using u8/u16 field of the struct
-	// directly. However reading back the data (as u32) in HashBucket.find
-	// leads to various memory stalls. So it is way faster to manually build the data
-	// in u32 (aka x86 register).
-	//
-	// Warning the order of data in hash_key/key0/key1 depends on the nVifBlock struct
-	u32 hash_key = (u32)(upkType & 0xFF) << 8 | (vifRegs.num & 0xFF);
-
-	u32 key1 = ((u32)vifRegs.cycle.wl << 24) | ((u32)vifRegs.cycle.cl << 16) | ((u32)(vif.start_aligned & 0xFF) << 8) | ((u32)vifRegs.mode & 0xFF);
-	if ((upkType & 0xf) != 9)
-		key1 &= 0xFFFF01FF;
-
 	// Zero out the mask parameter if it's unused -- games leave random junk
 	// values here which cause false recblock cache misses.
-	u32 key0 = doMask ? vifRegs.mask : 0;
-
-	block.hash_key = hash_key;
-	block.key0 = key0;
-	block.key1 = key1;
+	dVifSetBlockKey(block, upkType, vifRegs.num & 0xFF, doMask ? vifRegs.mask : 0,
+		vifRegs.cycle.cl, vifRegs.cycle.wl, vif.start_aligned & 0xFF, vifRegs.mode & 0xFF);
 
 	//DevCon.WriteLn("nVif%d: Recompiled Block!", idx);
 	//DevCon.WriteLn(L"[num=% 3d][upkType=0x%02x][scl=%d][cl=%d][wl=%d][mode=%d][m=%d][mask=%s]",
@@ -540,6 +556,11 @@ _vifT __fi void dVifUnpack(const u8* data, bool isFill)
 	if (!b) [[unlikely]]
 	{
 		b = dVifCompile<idx>(block, isFill);
+		v.stats.misses[upkType & 0x3f]++;
+	}
+	else
+	{
+		v.stats.hits[upkType & 0x3f]++;
 	}
 
 	{ // Execute the block
@@ -66,6 +66,13 @@ u32 g_iopCyclePenalty;
 static EEINST* s_pInstCache = nullptr;
 static u32 s_nInstCacheSize = 0;
 
+// Number of translated blocks which reside (at least partially) in each page of IOP RAM,
+// indexed by physical page so that all mirrors share a counter. Clears which land in a
+// page without any translated code can skip the per-word block lookup entirely, which is
+// the common case for module loading, SIF/SPU2 DMA, and stack/heap stores. Recompiled
+// stores also check it to write clean pages directly, without calling the memory handlers.
+u16 g_psxCodePageBlocks[Ps2MemSize::TotalIopRam >> __pageshift];
+
 static BASEBLOCK* s_pCurBlock = nullptr;
 static BASEBLOCKEX* s_pCurBlockEx = nullptr;
 
@@ -89,6 +96,7 @@ void rpsxpropBSC(EEINST* prev, EEINST* pinst);
 
 static void iopClearRecLUT(BASEBLOCK* base, int count);
 static void iopRecError(int err);
+static void iopMarkCodePages(const BASEBLOCKEX& block, s32 delta);
 
 #define PSX_GETBLOCK(x) PC_GETBLOCK_(x, psxRecLUT)
 
@@ -1027,6 +1035,7 @@ void recResetIOP()
 
 	recBlocks.Reset();
 	g_psxMaxRecMem = 0;
+	std::memset(g_psxCodePageBlocks, 0, sizeof(g_psxCodePageBlocks));
 
 	psxbranch = 0;
 }
@@ -1048,6 +1057,32 @@ static void iopClearRecLUT(BASEBLOCK* base, int count)
 		base[i].SetFnptr((uptr)iopJITCompile);
 }
 
+static __fi bool iopIsRamHwAddr(u32 hwaddr)
+{
+	return (hwaddr < Ps2MemSize::TotalIopRam);
+}
+
+static __fi u32 iopCodePageIndex(u32 hwaddr)
+{
+	return (hwaddr & (Ps2MemSize::ExposedIopRam - 1)) >> __pageshift;
+}
+
+// Adds (or removes, with a negative delta) a translated block to the code page counters of
+// every RAM page it spans. Blocks in ROM are never written to, so they aren't tracked.
+static void iopMarkCodePages(const BASEBLOCKEX& block, s32 delta)
+{
+	if (!iopIsRamHwAddr(block.startpc) || block.size == 0)
+		return;
+
+	const u32 end = block.startpc + block.size * 4;
+	for (u32 addr = block.startpc & ~__pagemask; addr < end; addr += __pagesize)
+	{
+		u16& count = g_psxCodePageBlocks[iopCodePageIndex(addr)];
+		pxAssert(delta > 0 || count > 0);
+		count += delta;
+	}
+}
+
 static __noinline s32 recExecuteBlock(s32 eeCycles)
 {
 	psxRegs.iopBreak = 0;
@@ -1119,6 +1154,9 @@ static __fi u32 psxRecClearMem(u32 pc)
 
 	if (toRemoveFirst != blockidx)
 	{
+		for (int i = toRemoveFirst; i < blockidx; i++)
+			iopMarkCodePages(*recBlocks[i], -1);
+
 		recBlocks.Remove(toRemoveFirst, (blockidx - 1));
 	}
 
@@ -1139,9 +1177,25 @@ static __fi u32 psxRecClearMem(u32 pc)
 
 static __fi void recClearIOP(u32 Addr, u32 Size)
 {
+	const u32 end = Addr + Size * 4;
 	u32 pc = Addr;
-	while (pc < Addr + Size * 4)
+	while (pc < end)
+	{
+		// Nothing has been compiled past g_psxMaxRecMem, so the rest of the range is clean.
+		if (pc >= g_psxMaxRecMem)
+			break;
+
+		// Pages of RAM with no translated code can't contain any blocks to clear, so
+		// stores and DMA into data pages are skipped a whole page at a time.
+		const u32 hwaddr = HWADDR(pc);
+		if (iopIsRamHwAddr(hwaddr) && g_psxCodePageBlocks[iopCodePageIndex(hwaddr)] == 0)
+		{
+			pc = std::min((pc & ~__pagemask) + __pagesize, end);
+			continue;
+		}
+
 		pc += PSXREC_CLEARM(pc);
+	}
 }
 
 void psxSetBranchReg()
@@ -1664,6 +1718,8 @@ static void iopRecRecompile(const u32 startpc)
 
 	if (!s_pCurBlockEx || s_pCurBlockEx->startpc != HWADDR(startpc))
 		s_pCurBlockEx = recBlocks.New(HWADDR(startpc), (uptr)recPtr);
+	else
+		iopMarkCodePages(*s_pCurBlockEx, -1);
 
 	psxbranch = 0;
 
@@ -1803,6 +1859,7 @@ StartRecomp:
 
 	pxAssert((psxpc - startpc) >> 2 <= 0xffff);
 	s_pCurBlockEx->size = (psxpc - startpc) >> 2;
+	iopMarkCodePages(*s_pCurBlockEx, 1);
 
 	if (!(psxpc & 0x10000000))
 		g_psxMaxRecMem = std::max((psxpc & ~0xa0000000), g_psxMaxRecMem);
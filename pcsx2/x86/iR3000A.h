@@ -23,6 +23,7 @@ static const int psxInstCycles_Load = 0;
 #define PSX_LO XMMGPR_LO
 
 extern uptr psxRecLUT[];
+extern u16 g_psxCodePageBlocks[];
 
 void _psxFlushConstReg(int reg);
 void _psxFlushConstRegs();
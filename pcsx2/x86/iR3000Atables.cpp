@@ -1189,20 +1189,75 @@ static void rpsxLW()
 	rpsxLoad(32, false);
 }
 
-static void rpsxSB()
+static void rpsxStore(int size)
 {
 	rpsxCalcAddressOperand();
 	rpsxCalcStoreOperand();
 	_psxFlushCall(FLUSH_FULLVTLB);
-	xFastCall((void*)iopMemWrite8);
+
+	// Stores to RAM are written directly, as long as the target page doesn't contain any
+	// translated code (which the handlers need to clear) and the cache isn't isolated.
+	// Everything else, including hardware registers, goes through the handlers.
+	xTEST(arg1regd, 0x1f800000);
+	xForwardJNZ8 not_ram;
+
+	const xRegister32 page(arg3reg.GetId());
+	xMOV(eax, arg1regd);
+	xAND(eax, Ps2MemSize::ExposedIopRam - 1);
+	xMOV(page, eax);
+	xSHR(page, __pageshift);
+	xCMP(ptr16[xComplexAddress(arg4reg, g_psxCodePageBlocks, arg3reg * 2)], 0);
+	xForwardJNZ8 code_page;
+	xTEST(ptr32[&psxRegs.CP0.n.Status], 0x10000);
+	xForwardJNZ8 isolated;
+
+	auto addr = xComplexAddress(arg3reg, iopMem->Main, rax);
+	switch (size)
+	{
+		case 8:
+			xMOV(ptr8[addr], xRegister8(arg2regd));
+			break;
+		case 16:
+			xMOV(ptr16[addr], xRegister16(arg2regd));
+			break;
+		case 32:
+			xMOV(ptr32[addr], arg2regd);
+			break;
+
+			jNO_DEFAULT
+	}
+
+	xForwardJump8 done;
+	not_ram.SetTarget();
+	code_page.SetTarget();
+	isolated.SetTarget();
+
+	switch (size)
+	{
+		case 8:
+			xFastCall((void*)iopMemWrite8);
+			break;
+		case 16:
+			xFastCall((void*)iopMemWrite16);
+			break;
+		case 32:
+			xFastCall((void*)iopMemWrite32);
+			break;
+
+			jNO_DEFAULT
+	}
+
+	done.SetTarget();
+}
+
+static void rpsxSB()
+{
+	rpsxStore(8);
 }
 
 static void rpsxSH()
 {
-	rpsxCalcAddressOperand();
-	rpsxCalcStoreOperand();
-	_psxFlushCall(FLUSH_FULLVTLB);
-	xFastCall((void*)iopMemWrite16);
+	rpsxStore(16);
 }
 
 static void rpsxSW()
@@ -1215,10 +1270,7 @@ static void rpsxSW()
 		return;
 	}
 
-	rpsxCalcAddressOperand();
-	rpsxCalcStoreOperand();
-	_psxFlushCall(FLUSH_FULLVTLB);
-	xFastCall((void*)iopMemWrite32);
+	rpsxStore(32);
 }
 
 //// SLL
@@ -5,6 +5,8 @@
 #include "Memory.h"
 #include "DebugTools/Debug.h"
 
+#include <algorithm>
+
 using namespace R5900;
 
 // This should be moved to analysis...
@@ -1615,3 +1617,232 @@ void recBackpropMMI(u32 code, EEINST* prev, EEINST* pinst)
 		break;
 	}
 }
+
+PollingLoopPass::PollingLoopPass() = default;
+
+PollingLoopPass::~PollingLoopPass() = default;
+
+bool PollingLoopPass::Analyze(u32 loop_start, u32 loop_end)
+{
+	if (loop_end <= loop_start || ((loop_end - loop_start) >> 2) > MAX_LOOP_INSTRUCTIONS)
+		return false;
+
+	m_loop_start = loop_start;
+	m_loop_end = loop_end;
+	m_code_ranges.clear();
+	m_code_ranges.emplace_back(loop_start, loop_end);
+
+	// The back edge itself can't link, otherwise we'd be looking at a call, not a loop.
+	if (!ReadCode(loop_end - 8) || _Opcode_ == 003 || (_Opcode_ == 001 && (_Rt_ & 020)))
+		return false;
+
+	for (u32 pc = loop_start; pc < loop_end; pc += 4)
+	{
+		if (pc == loop_end - 8)
+			continue;
+
+		if (!ReadCode(pc))
+			return false;
+
+		// JAL to a polling helper. The delay slot runs first, then the helper.
+		if (_Opcode_ == 003)
+		{
+			const u32 target = (_InstrucTarget_ << 2) | ((pc + 4) & 0xf0000000);
+			if (pc + 4 == loop_end - 8 || !ReadCode(pc + 4) || !AnalyzeInstruction(pc + 4))
+				return false;
+
+			if (!WriteReg(31, true))
+				return false;
+
+			m_const_values[31] = pc + 8;
+			m_consts |= 1u << 31;
+
+			if (!AnalyzeHelper(target))
+				return false;
+
+			pc += 4;
+			continue;
+		}
+
+		if (!AnalyzeInstruction(pc))
+			return false;
+	}
+
+	return true;
+}
+
+bool PollingLoopPass::AnalyzeHelper(u32 start)
+{
+	for (u32 pc = start; pc < start + MAX_HELPER_INSTRUCTIONS * 4; pc += 4)
+	{
+		if (!ReadCode(pc))
+			return false;
+
+		// JR RA ends the helper, after the delay slot.
+		if (_Opcode_ == 0 && _Funct_ == 010 && _Rs_ == 31)
+		{
+			ReadReg(31);
+			if (std::find(m_code_ranges.begin(), m_code_ranges.end(), std::make_pair(start, pc + 8)) == m_code_ranges.end())
+				m_code_ranges.emplace_back(start, pc + 8);
+			return ReadCode(pc + 4) && AnalyzeInstruction(pc + 4);
+		}
+
+		// Keep it simple, only straight-line leaf functions.
+		if (_Opcode_ == 001 || _Opcode_ == 002 || _Opcode_ == 003 || (_Opcode_ & 074) == 004 || (_Opcode_ & 074) == 024 ||
+			(_Opcode_ == 0 && (_Funct_ == 010 || _Funct_ == 011)))
+		{
+			return false;
+		}
+
+		if (!AnalyzeInstruction(pc))
+			return false;
+	}
+
+	return false;
+}
+
+bool PollingLoopPass::ReadCode(u32 pc)
+{
+	// Don't use memRead32() here, we don't want a TLB miss exception if the target is bogus.
+	const u32* ptr = static_cast<const u32*>(PSM(pc));
+	if (!ptr)
+		return false;
+
+	cpuRegs.code = *ptr;
+	return true;
+}
+
+void PollingLoopPass::ReadReg(u32 reg)
+{
+	if (!(m_loads & (1u << reg)))
+		m_reads |= 1u << reg;
+}
+
+bool PollingLoopPass::WriteReg(u32 reg, bool from_loads)
+{
+	m_consts &= ~(1u << reg);
+	m_consts |= 1u;
+
+	if (from_loads)
+	{
+		m_loads |= 1u << reg;
+		return true;
+	}
+
+	// Writing a register the loop has already consumed means iterations can differ.
+	return !(m_reads & (1u << reg));
+}
+
+bool PollingLoopPass::IsFifoAddress(u32 base_reg, s32 offset) const
+{
+	if (!(m_consts & (1u << base_reg)))
+		return false;
+
+	// Reading the VIF/GIF/IPU FIFOs pops data, so it isn't a harmless poll.
+	const u32 addr = (m_const_values[base_reg] + offset) & 0x1fffffff;
+	return (addr >= 0x10004000 && addr < 0x10008000);
+}
+
+bool PollingLoopPass::AnalyzeInstruction(u32 pc)
+{
+	// nop
+	if (cpuRegs.code == 0)
+		return true;
+
+	// cache, sync
+	if (_Opcode_ == 057 || (_Opcode_ == 0 && _Funct_ == 017))
+		return true;
+
+	// imm arithmetic
+	if ((_Opcode_ & 070) == 010 || (_Opcode_ & 076) == 030)
+	{
+		const bool from_loads = (m_loads & (1u << _Rs_)) != 0;
+		if (!from_loads)
+			ReadReg(_Rs_);
+
+		const bool rs_const = (m_consts & (1u << _Rs_)) != 0;
+		const u32 rs_value = m_const_values[_Rs_];
+		const u32 rt = _Rt_;
+		if (!WriteReg(rt, from_loads))
+			return false;
+
+		if (rt != 0)
+		{
+			// Track LUI/ORI/ADDIU address construction.
+			if (_Opcode_ == 017)
+			{
+				m_const_values[rt] = static_cast<u32>(_ImmU_) << 16;
+				m_consts |= 1u << rt;
+			}
+			else if (rs_const && (_Opcode_ == 015 || _Opcode_ == 011))
+			{
+				m_const_values[rt] = (_Opcode_ == 015) ? (rs_value | _ImmU_) : (rs_value + _Imm_);
+				m_consts |= 1u << rt;
+			}
+		}
+
+		return true;
+	}
+
+	// common register arithmetic instructions
+	if (_Opcode_ == 0 && (_Funct_ & 060) == 040 && (_Funct_ & 076) != 050)
+	{
+		const bool from_loads = (m_loads & (1u << _Rs_)) && (m_loads & (1u << _Rt_));
+		if (!from_loads)
+		{
+			ReadReg(_Rs_);
+			ReadReg(_Rt_);
+		}
+		return WriteReg(_Rd_, from_loads);
+	}
+
+	// shifts by immediate
+	if (_Opcode_ == 0 && _Rs_ == 0 &&
+		(_Funct_ == 000 || _Funct_ == 002 || _Funct_ == 003 || _Funct_ == 070 || _Funct_ == 072 ||
+			_Funct_ == 073 || _Funct_ == 074 || _Funct_ == 076 || _Funct_ == 077))
+	{
+		const bool from_loads = (m_loads & (1u << _Rt_)) != 0;
+		if (!from_loads)
+			ReadReg(_Rt_);
+		return WriteReg(_Rd_, from_loads);
+	}
+
+	// loads, only from addresses we can see. Anything else could be walking a list or a FIFO.
+	if ((_Opcode_ & 070) == 040 || (_Opcode_ & 076) == 032 || _Opcode_ == 067)
+	{
+		if (!(m_consts & (1u << _Rs_)) || IsFifoAddress(_Rs_, _Imm_))
+			return false;
+
+		const bool from_loads = (m_loads & (1u << _Rs_)) != 0;
+		if (!from_loads)
+			ReadReg(_Rs_);
+		return WriteReg(_Rt_, from_loads);
+	}
+
+	// mfc*, cfc*
+	if ((_Opcode_ & 074) == 020 && _Rs_ < 4)
+		return WriteReg(_Rt_, true);
+
+	// conditional branches, which either stay in the loop or leave it forwards. Anything before the
+	// loop would run code we haven't looked at.
+	if ((_Opcode_ & 074) == 004 || (_Opcode_ & 074) == 024 || (_Opcode_ == 001 && (_Rt_ & 036) == 0))
+	{
+		const u32 target = pc + 4 + (static_cast<u32>(_Imm_) << 2);
+		if (target < m_loop_start)
+			return false;
+
+		ReadReg(_Rs_);
+		if (_Opcode_ != 001)
+			ReadReg(_Rt_);
+		return true;
+	}
+
+	// unconditional jumps within the loop
+	if (_Opcode_ == 002)
+	{
+		const u32 target = (_InstrucTarget_ << 2) | ((pc + 4) & 0xf0000000);
+		return (target >= m_loop_start && target < m_loop_end);
+	}
+
+	return false;
+}
@@ -6,6 +6,9 @@
 #include "iR5900.h"
 #include "iCore.h"
 
+#include <utility>
+#include <vector>
+
 namespace R5900
 {
 	class AnalysisPass
@@ -59,6 +62,51 @@ namespace R5900
 
 		void Run(u32 start, u32 end, EEINST* inst_cache) override;
 	};
+
+	/// Detects loops which span several blocks, or call a small leaf function, but otherwise only
+	/// poll memory or hardware registers (INTC_STAT, D_STAT, VIF/GIF STAT, SIF flags, ...). Every
+	/// iteration of such a loop does the same thing until an event changes the polled state, so
+	/// the loop's back edge can be fast-forwarded to the next scheduled event.
+	class PollingLoopPass final : public AnalysisPass
+	{
+	public:
+		PollingLoopPass();
+		~PollingLoopPass();
+
+		/// Returns true if the loop from loop_start up to loop_end (which covers the back edge
+		/// branch and its delay slot) has no side effects apart from loads.
+		bool Analyze(u32 loop_start, u32 loop_end);
+
+		/// Returns the [start, end) ranges of code the last successful Analyze() looked at: the
+		/// loop itself, and any helpers it calls. If any of it changes, the result no longer holds.
+		const std::vector<std::pair<u32, u32>>& GetCodeRanges() const { return m_code_ranges; }
+
+	private:
+		static constexpr u32 MAX_LOOP_INSTRUCTIONS = 32;
+		static constexpr u32 MAX_HELPER_INSTRUCTIONS = 16;
+
+		bool AnalyzeInstruction(u32 pc);
+		bool AnalyzeHelper(u32 start);
+		bool ReadCode(u32 pc);
+
+		void ReadReg(u32 reg);
+		bool WriteReg(u32 reg, bool from_loads);
+		bool IsFifoAddress(u32 base_reg, s32 offset) const;
+
+		u32 m_loop_start = 0;
+		u32 m_loop_end = 0;
+
+		// Registers read before being written in this iteration, and registers whose value only
+		// depends on this iteration's loads and constants. See the s_nBlockFF check in iR5900.cpp.
+		u32 m_reads = 0;
+		u32 m_loads = 1;
+
+		// Registers with a known constant value, used to spot loads from the FIFOs.
+		u32 m_consts = 1;
+		u32 m_const_values[32] = {};
+
+		std::vector<std::pair<u32, u32>> m_code_ranges;
+	};
 } // namespace R5900
 
 void recBackpropBSC(u32 code, EEINST* prev, EEINST* pinst);
@@ -93,6 +93,10 @@ u32 s_nEndBlock = 0; // what pc the current block ends
 u32 s_branchTo;
 static bool s_nBlockFF;
 
+// Code outside of the current block which s_nBlockFF was decided on. Overwriting it doesn't clear
+// this block, so it gets checked again before each fast-forward.
+static std::vector<std::pair<u32, u32>> s_nBlockFFCode;
+
 // save states for branches
 GPR_reg64 s_saveConstRegs[32];
 static u32 s_saveHasConstReg = 0, s_saveFlushedConstReg = 0;
@@ -1390,6 +1394,16 @@ static void iBranchTest(u32 newpc)
 
 	if (EmuConfig.Speedhacks.WaitLoop && s_nBlockFF && newpc == s_branchTo)
 	{
+		std::vector<xForwardJump32> code_changed;
+		for (const auto& [start, end] : s_nBlockFFCode)
+		{
+			for (u32 pc = start; pc < end; pc += 4)
+			{
+				xCMP(ptr32[PSM(pc)], *(u32*)PSM(pc));
+				code_changed.emplace_back(Jcc_NotEqual);
+			}
+		}
+
 		xMOV(rax, ptr64[&cpuRegs.nextEventCycle]);
 		xADD(ptr64[&cpuRegs.cycle], scaleblockcycles());
 		xCMP(rax, ptr64[&cpuRegs.cycle]);
@@ -1397,21 +1411,26 @@ static void iBranchTest(u32 newpc)
 		xMOV(ptr64[&cpuRegs.cycle], rax);
 
 		xJMP((void*)DispatcherEvent);
-	}
-	else
-	{
-		xMOV(rax, ptr64[&cpuRegs.cycle]);
-		xADD(rax, scaleblockcycles());
-		xMOV(ptr64[&cpuRegs.cycle], rax); // update cycles
-		xSUB(rax, ptr64[&cpuRegs.nextEventCycle]);
 
-		if (newpc == 0xffffffff)
-			xJS(DispatcherReg);
-		else
-			recBlocks.Link(HWADDR(newpc), xJcc32(Jcc_Signed));
+		if (code_changed.empty())
+			return;
 
-		xJMP((void*)DispatcherEvent);
+		// Fall back to a normal branch if the loop might not be a polling loop anymore.
+		for (const xForwardJump32& jump : code_changed)
+			jump.SetTarget();
 	}
+
+	xMOV(rax, ptr64[&cpuRegs.cycle]);
+	xADD(rax, scaleblockcycles());
+	xMOV(ptr64[&cpuRegs.cycle], rax); // update cycles
+	xSUB(rax, ptr64[&cpuRegs.nextEventCycle]);
+
+	if (newpc == 0xffffffff)
+		xJS(DispatcherReg);
+	else
+		recBlocks.Link(HWADDR(newpc), xJcc32(Jcc_Signed));
+
+	xJMP((void*)DispatcherEvent);
 }
 
 // opcode 'code' modifies:
@@ -2474,6 +2493,7 @@ StartRecomp:
 	// which alter the machine state apart from registers, it will do the same thing on every
 	// iteration.
 	s_nBlockFF = false;
+	s_nBlockFFCode.clear();
 	if (s_branchTo == startpc)
 	{
 		s_nBlockFF = true;
@@ -2554,6 +2574,24 @@ StartRecomp:
 	else
 	{
 		is_timeout_loop = false;
+
+		// Same idea for loops which span several blocks or call a small polling helper. The back
+		// edge is in this block, so the whole loop has already been seen by the time we get here.
+		PollingLoopPass pass;
+		if (EmuConfig.Speedhacks.WaitLoop && s_branchTo < startpc && pass.Analyze(s_branchTo, s_nEndBlock))
+		{
+			eeRecPerfLog.Write("Fast-forwarding polling loop at 0x%08X -> 0x%08X", s_branchTo, s_nEndBlock);
+			s_nBlockFF = true;
+
+			// Only the parts outside of this block need checking, this block covers the rest.
+			for (const auto& [start, end] : pass.GetCodeRanges())
+			{
+				if (start < startpc)
+					s_nBlockFFCode.emplace_back(start, std::min(end, startpc));
+				if (end > s_nEndBlock)
+					s_nBlockFFCode.emplace_back(std::max(start, s_nEndBlock), end);
+			}
+		}
 	}
 
 	// rec info //
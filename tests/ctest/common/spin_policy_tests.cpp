@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "common/HostSys.h"
+#include "common/Threading.h"
+#include <gtest/gtest.h>
+
+using namespace Threading;
+
+// Simulates waits where the work shows up after arrival_ns. If that's after we stop spinning,
+// the wait also includes the time taken to wake the thread back up.
+static void RecordWaits(SpinPolicy& policy, u64 arrival_ns, u32 count)
+{
+	static constexpr u64 WAKE_NS = 10000;
+	for (u32 i = 0; i < count; i++)
+	{
+		const bool slept = arrival_ns > policy.GetSpinTime();
+		policy.RecordWait(slept ? (arrival_ns + WAKE_NS) : arrival_ns, slept);
+	}
+}
+
+TEST(SpinPolicy, SpinsForShortWaits)
+{
+	SpinPolicy policy;
+	policy.SetMode(SpinPolicy::Mode::Adaptive);
+	EXPECT_EQ(policy.GetSpinTime(), 0u);
+
+	RecordWaits(policy, 1500, 1024);
+	EXPECT_GE(policy.GetSpinTime(), 2000u);
+	EXPECT_LE(policy.GetSpinTime(), 4000u);
+}
+
+TEST(SpinPolicy, SleepsForLongWaits)
+{
+	SpinPolicy policy;
+	policy.SetMode(SpinPolicy::Mode::Adaptive);
+	RecordWaits(policy, 1500, 1024);
+	ASSERT_GT(policy.GetSpinTime(), 0u);
+
+	RecordWaits(policy, 5000000, 4096);
+	EXPECT_EQ(policy.GetSpinTime(), 0u);
+}
+
+TEST(SpinPolicy, SleepsWhenWakingIsCheaper)
+{
+	SpinPolicy policy;
+	policy.SetMode(SpinPolicy::Mode::Adaptive);
+
+	// Spinning for 30us would cost more than the 10us it takes to wake up.
+	RecordWaits(policy, 30000, 1024);
+	EXPECT_EQ(policy.GetSpinTime(), 0u);
+}
+
+TEST(SpinPolicy, FixedModes)
+{
+	SpinPolicy policy;
+	policy.SetMode(SpinPolicy::Mode::Sleep);
+	RecordWaits(policy, 1500, 1024);
+	EXPECT_EQ(policy.GetSpinTime(), 0u);
+
+	policy.SetMode(SpinPolicy::Mode::Spin);
+	RecordWaits(policy, 5000000, 1024);
+	EXPECT_EQ(policy.GetSpinTime(), SPIN_TIME_NS);
+}
+
+TEST(SpinPolicy, Histogram)
+{
+	SpinPolicy policy;
+	policy.RecordWait(500, false);
+	policy.RecordWait(1500, false);
+	policy.RecordWait(3000, false);
+	policy.RecordWait(1000000000, true);
+
+	SpinPolicy::Histogram histogram = {};
+	policy.CollectHistogram(histogram);
+	EXPECT_EQ(histogram[0], 1u);
+	EXPECT_EQ(histogram[1], 1u);
+	EXPECT_EQ(histogram[2], 1u);
+	EXPECT_EQ(histogram[SpinPolicy::NUM_BUCKETS - 1], 1u);
+	EXPECT_EQ(policy.CollectWaitTime(), 1000005000u);
+	EXPECT_EQ(policy.CollectWaitTime(), 0u);
+
+	// Collecting takes the counts.
+	SpinPolicy::Histogram empty = {};
+	policy.CollectHistogram(empty);
+	EXPECT_EQ(empty, SpinPolicy::Histogram{});
+}
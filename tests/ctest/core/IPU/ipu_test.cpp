@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/IPU/IPU_MultiISA.h"
+#include "pcsx2/IPU/yuv2rgb.h"
+#include "../MultiISATest.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+
+MULTI_ISA_UNSHARED_START
+
+// Dequantized coefficients are saturated to 12 bits before they reach the IDCT.
+static void RandomBlock(std::mt19937& rng, s16* block, int density)
+{
+	std::uniform_int_distribution<int> coefficient(-2048, 2047);
+	std::uniform_int_distribution<int> present(0, 63);
+
+	for (int i = 0; i < 64; i++)
+		block[i] = (i == 0 || present(rng) < density) ? static_cast<s16>(coefficient(rng)) : 0;
+}
+
+static void CompareIDCT(const s16* block)
+{
+	alignas(16) s16 expected[64];
+	alignas(16) s16 actual[64];
+	std::memcpy(expected, block, sizeof(expected));
+	std::memcpy(actual, block, sizeof(actual));
+
+	IDCT_Block_reference(expected);
+	IDCT_Block(actual);
+
+	for (int i = 0; i < 64; i++)
+		EXPECT_EQ(expected[i], actual[i]) << "coefficient " << i;
+}
+
+MULTI_ISA_TEST(IPU, IDCTMatchesReference)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	std::mt19937 rng(12345);
+	alignas(16) s16 block[64];
+	for (int density : {0, 1, 8, 32, 64})
+	{
+		for (int i = 0; i < 500; i++)
+		{
+			RandomBlock(rng, block, density);
+			CompareIDCT(block);
+		}
+	}
+}
+
+MULTI_ISA_TEST(IPU, IDCTMatchesReferenceAtFullScale)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	alignas(16) s16 block[64];
+	for (s16 value : {s16(-2048), s16(2047)})
+	{
+		for (int i = 0; i < 64; i++)
+		{
+			std::memset(block, 0, sizeof(block));
+			block[i] = value;
+			CompareIDCT(block);
+		}
+
+		for (int i = 0; i < 64; i++)
+			block[i] = (i & 1) ? value : -value;
+		CompareIDCT(block);
+	}
+}
+
+static void RandomMacroblock(std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> byte(0, 255);
+	u8* const data = reinterpret_cast<u8*>(&decoder.mb8);
+	for (size_t i = 0; i < sizeof(decoder.mb8); i++)
+		data[i] = static_cast<u8>(byte(rng));
+}
+
+static void CompareCSC(int sgn)
+{
+	macroblock_rgb32 expected;
+	ipu_csc_reference(decoder.mb8, decoder.rgb32, sgn);
+	std::memcpy(&expected, &decoder.rgb32, sizeof(expected));
+
+	std::memset(&decoder.rgb32, 0xcc, sizeof(decoder.rgb32));
+	ipu_csc(decoder.mb8, decoder.rgb32, sgn);
+
+	EXPECT_EQ(std::memcmp(&expected, &decoder.rgb32, sizeof(expected)), 0);
+}
+
+MULTI_ISA_TEST(IPU, CSCMatchesReference)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	std::mt19937 rng(23456);
+	const u16 thresholds[][2] = {{0, 0}, {0, 0x40}, {0x20, 0}, {0x20, 0x80}, {0x100, 0x1ff}};
+	for (const auto& thresh : thresholds)
+	{
+		g_ipu_thresh[0] = thresh[0];
+		g_ipu_thresh[1] = thresh[1];
+
+		for (int i = 0; i < 100; i++)
+		{
+			RandomMacroblock(rng);
+			CompareCSC(i & 1);
+		}
+	}
+
+	g_ipu_thresh[0] = 0;
+	g_ipu_thresh[1] = 0;
+}
+
+MULTI_ISA_TEST(IPU, DitherMatchesReference)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	std::mt19937 rng(34567);
+	std::uniform_int_distribution<int> byte(0, 255);
+	const u8 alphas[] = {0x00, 0x40, 0x80, 0xff};
+
+	for (int i = 0; i < 200; i++)
+	{
+		alignas(16) macroblock_rgb32 rgb32;
+		for (auto& row : rgb32.c)
+		{
+			for (auto& pixel : row)
+			{
+				pixel.r = static_cast<u8>(byte(rng));
+				pixel.g = static_cast<u8>(byte(rng));
+				pixel.b = static_cast<u8>(byte(rng));
+				pixel.a = alphas[byte(rng) & 3];
+			}
+		}
+
+		for (int dte = 0; dte < 2; dte++)
+		{
+			alignas(16) macroblock_rgb16 expected;
+			alignas(16) macroblock_rgb16 actual;
+			ipu_dither_reference(rgb32, expected, dte);
+			ipu_dither(rgb32, actual, dte);
+			EXPECT_EQ(std::memcmp(&expected, &actual, sizeof(expected)), 0) << "dte " << dte;
+		}
+	}
+}
+
+MULTI_ISA_UNSHARED_END
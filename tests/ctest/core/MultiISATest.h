@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "pcsx2/GS/MultiISA.h"
+
+#include <gtest/gtest.h>
+
+#include "cpuinfo.h"
+
+#ifdef MULTI_ISA_UNSHARED_COMPILATION
+
+enum class TestISA
+{
+	isa_sse4,
+	isa_avx,
+	isa_avx2,
+	isa_native,
+};
+
+static bool CheckCapabilities(TestISA required_caps)
+{
+	cpuinfo_initialize();
+	if (required_caps == TestISA::isa_avx && !cpuinfo_has_x86_avx())
+		return false;
+	if (required_caps == TestISA::isa_avx2 && !cpuinfo_has_x86_avx2())
+		return false;
+
+	return true;
+}
+
+#define MULTI_ISA_STRINGIZE_(x) #x
+#define MULTI_ISA_STRINGIZE(x) MULTI_ISA_STRINGIZE_(x)
+
+#define MULTI_ISA_CONCAT_(a, b) a##b
+#define MULTI_ISA_CONCAT(a, b) MULTI_ISA_CONCAT_(a, b)
+
+#define MULTI_ISA_TEST(group, name) TEST(MULTI_ISA_CONCAT(MULTI_ISA_CONCAT(MULTI_ISA_UNSHARED_COMPILATION, _), group), name)
+#define SKIP_IF_UNSUPPORTED() \
+	if (!CheckCapabilities(TestISA::MULTI_ISA_UNSHARED_COMPILATION)) { \
+		GTEST_SKIP() << "Host CPU does not support " MULTI_ISA_STRINGIZE(MULTI_ISA_UNSHARED_COMPILATION); \
+	}
+
+#else
+
+#define MULTI_ISA_TEST(group, name) TEST(group, name)
+#define SKIP_IF_UNSUPPORTED()
+
+#endif
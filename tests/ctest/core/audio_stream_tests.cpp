@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Host/AudioStream.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+	static constexpr u32 SAMPLE_RATE = 48000;
+	static constexpr u32 CALLBACK_FRAMES = 480;
+
+	// Stands in for a backend which pulls a fixed number of frames each callback.
+	class NullBackendStream final : public AudioStream
+	{
+	public:
+		NullBackendStream(const AudioStreamParameters& parameters)
+			: AudioStream(SAMPLE_RATE, parameters)
+		{
+			BaseInitialize(&StereoSampleReaderImpl, true);
+		}
+
+		using AudioStream::ReadFrames;
+	};
+
+	struct LatencyResult
+	{
+		float max_latency_ms = 0.0f;
+		u32 discontinuities = 0;
+	};
+
+	// Writes a ramp (each frame holds its own index) at drift times the output rate, and reads it back in
+	// callback sized pieces. Since the resampler is exact for linear input, the value read back tells us how
+	// long ago that frame was written, and any jump in the ramp is an underrun or a dropped chunk.
+	static LatencyResult RunStream(NullBackendStream& stream, float drift, u32 seconds, u32 warmup_seconds)
+	{
+		LatencyResult result;
+		std::array<float, AudioStream::CHUNK_SIZE * AudioStream::NUM_INPUT_CHANNELS> chunk;
+		std::array<float, CALLBACK_FRAMES * AudioStream::NUM_INPUT_CHANNELS> output;
+		u32 written = 0;
+		float pending = 0.0f;
+		float last_value = 0.0f;
+
+		const u32 callbacks = (seconds * SAMPLE_RATE) / CALLBACK_FRAMES;
+		const u32 warmup_callbacks = (warmup_seconds * SAMPLE_RATE) / CALLBACK_FRAMES;
+		for (u32 i = 0; i < callbacks; i++)
+		{
+			pending += static_cast<float>(CALLBACK_FRAMES) * drift;
+			while (pending >= static_cast<float>(AudioStream::CHUNK_SIZE))
+			{
+				for (u32 j = 0; j < AudioStream::CHUNK_SIZE; j++)
+				{
+					chunk[j * 2 + 0] = static_cast<float>(written + j);
+					chunk[j * 2 + 1] = static_cast<float>(written + j);
+				}
+				stream.WriteChunk(chunk.data());
+				written += AudioStream::CHUNK_SIZE;
+				pending -= static_cast<float>(AudioStream::CHUNK_SIZE);
+			}
+
+			stream.ReadFrames(output.data(), CALLBACK_FRAMES);
+			if (i < warmup_callbacks)
+			{
+				last_value = output[(CALLBACK_FRAMES - 1) * 2];
+				continue;
+			}
+
+			for (u32 j = 0; j < CALLBACK_FRAMES; j++)
+			{
+				const float value = output[j * 2];
+				const float delta = value - last_value;
+				if (delta < 0.75f || delta > 1.25f)
+					result.discontinuities++;
+				last_value = value;
+			}
+
+			const float latency_ms = (static_cast<float>(written) - last_value) * 1000.0f / static_cast<float>(SAMPLE_RATE);
+			result.max_latency_ms = std::max(result.max_latency_ms, latency_ms);
+		}
+
+		return result;
+	}
+} // namespace
+
+TEST(AudioStream, LowLatencyResamplerTracksDrift)
+{
+	AudioStreamParameters params;
+	params.stretch_low_latency = true;
+
+	for (const float drift : {1.0f, 1.002f, 0.998f})
+	{
+		NullBackendStream stream(params);
+		const LatencyResult result = RunStream(stream, drift, 15, 10);
+		EXPECT_TRUE(stream.IsResamplerActive()) << "drift " << drift;
+		EXPECT_EQ(result.discontinuities, 0u) << "drift " << drift;
+		EXPECT_LT(result.max_latency_ms, 30.0f) << "drift " << drift;
+	}
+}
+
+TEST(AudioStream, LowLatencyResamplerFallsBackToStretch)
+{
+	AudioStreamParameters params;
+	params.stretch_low_latency = true;
+
+	// 10% off is more than we can correct for without a pitch change.
+	NullBackendStream stream(params);
+	RunStream(stream, 1.1f, 5, 5);
+	EXPECT_FALSE(stream.IsResamplerActive());
+}
+
+TEST(AudioStream, ResamplerOnlyUsedInLowLatencyMode)
+{
+	AudioStreamParameters params;
+	NullBackendStream stream(params);
+	RunStream(stream, 1.0f, 1, 1);
+	EXPECT_FALSE(stream.IsResamplerActive());
+}
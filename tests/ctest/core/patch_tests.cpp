@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
+
 // Create a test that makes sure applying a given list of patch commands results
 // in a certain sequence of memory reads/writes.
 #define PATCH_TEST(name, ...) \
@@ -632,3 +634,162 @@ PATCH_TEST(ExtendedConditionalResetSkipCount,
 	ee.ExpectRead8(0x00200000, 0);
 	ee.ExpectWrite8(0x00200000, 0x12);
 }
+
+// *****************************************************************************
+// Dynamic patches
+// *****************************************************************************
+
+namespace
+{
+	static constexpr u32 DYNAMIC_PATCH_PC = 0x00100000;
+
+	/// Backs the mock with a map so that patterns can be matched against
+	/// replacements made by earlier patches. Only the writes are checked.
+	class DynamicPatchTest : public testing::Test
+	{
+	protected:
+		DynamicPatchTest()
+		{
+			ON_CALL(ee, Read32).WillByDefault([this](u32 address, bool* valid) {
+				if (valid)
+					*valid = true;
+				const auto it = memory.find(address);
+				return (it != memory.end()) ? it->second : 0u;
+			});
+			ON_CALL(ee, Write32).WillByDefault([this](u32 address, u32 value) {
+				memory[address] = value;
+				return true;
+			});
+		}
+
+		~DynamicPatchTest() override
+		{
+			Patch::LoadDynamicPatches({});
+		}
+
+		testing::NiceMock<MockMemoryInterface> ee;
+		std::map<u32, u32> memory;
+	};
+} // namespace
+
+static Patch::DynamicPatch BuildDynamicPatch(
+	std::vector<Patch::DynamicPatchEntry> pattern,
+	std::vector<Patch::DynamicPatchEntry> replacement)
+{
+	Patch::DynamicPatch patch;
+	patch.pattern = std::move(pattern);
+	patch.replacement = std::move(replacement);
+	return patch;
+}
+
+TEST_F(DynamicPatchTest, PnachBeforeGameDB)
+{
+	memory[DYNAMIC_PATCH_PC] = 0x11111111;
+	{
+		testing::InSequence seq;
+		EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC + 4, 1));
+		EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC + 4, 2));
+	}
+
+	Patch::ApplyDynamicPatches(
+		{BuildDynamicPatch({{0, 0x11111111}}, {{4, 1}})},
+		{BuildDynamicPatch({{0, 0x11111111}}, {{4, 2}})},
+		DYNAMIC_PATCH_PC, ee);
+	EXPECT_EQ(memory[DYNAMIC_PATCH_PC + 4], 2u);
+}
+
+TEST_F(DynamicPatchTest, ReplacementEnablesLaterMatch)
+{
+	memory[DYNAMIC_PATCH_PC] = 0x11111111;
+	{
+		testing::InSequence seq;
+		EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC, 0x22222222));
+		EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC + 4, 3));
+	}
+
+	Patch::ApplyDynamicPatches(
+		{BuildDynamicPatch({{0, 0x11111111}}, {{0, 0x22222222}})},
+		{BuildDynamicPatch({{0, 0x22222222}}, {{4, 3}})},
+		DYNAMIC_PATCH_PC, ee);
+}
+
+TEST_F(DynamicPatchTest, ReplacementDoesNotEnableEarlierMatch)
+{
+	memory[DYNAMIC_PATCH_PC] = 0x11111111;
+	EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC, 0x22222222));
+
+	Patch::ApplyDynamicPatches(
+		{BuildDynamicPatch({{0, 0x22222222}}, {{4, 3}})},
+		{BuildDynamicPatch({{0, 0x11111111}}, {{0, 0x22222222}})},
+		DYNAMIC_PATCH_PC, ee);
+}
+
+TEST_F(DynamicPatchTest, ReplacementDisablesLaterMatch)
+{
+	memory[DYNAMIC_PATCH_PC] = 0x11111111;
+	EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC, 0x22222222));
+
+	Patch::ApplyDynamicPatches(
+		{BuildDynamicPatch({{0, 0x11111111}}, {{0, 0x22222222}})},
+		{BuildDynamicPatch({{0, 0x11111111}}, {{4, 3}})},
+		DYNAMIC_PATCH_PC, ee);
+}
+
+TEST_F(DynamicPatchTest, ReplacementDisablesLaterMatchAtOtherOffset)
+{
+	memory[DYNAMIC_PATCH_PC] = 0x11111111;
+	memory[DYNAMIC_PATCH_PC + 8] = 0x33333333;
+	EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC + 8, 0x44444444));
+
+	Patch::ApplyDynamicPatches(
+		{BuildDynamicPatch({{0, 0x11111111}}, {{8, 0x44444444}})},
+		{BuildDynamicPatch({{8, 0x33333333}, {0, 0x11111111}}, {{4, 3}})},
+		DYNAMIC_PATCH_PC, ee);
+}
+
+TEST_F(DynamicPatchTest, EmptyPatternAlwaysMatches)
+{
+	{
+		testing::InSequence seq;
+		EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC + 4, 5));
+		EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC + 0x104, 5));
+	}
+
+	const std::vector<Patch::DynamicPatch> patches = {BuildDynamicPatch({}, {{4, 5}})};
+	Patch::ApplyDynamicPatches(patches, {}, DYNAMIC_PATCH_PC, ee);
+	Patch::ApplyDynamicPatches(patches, {}, DYNAMIC_PATCH_PC + 0x100, ee);
+}
+
+TEST_F(DynamicPatchTest, EmptyPatternEnablesLaterMatch)
+{
+	{
+		testing::InSequence seq;
+		EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC, 0x22222222));
+		EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC + 4, 3));
+	}
+
+	Patch::ApplyDynamicPatches(
+		{BuildDynamicPatch({}, {{0, 0x22222222}})},
+		{BuildDynamicPatch({{0, 0x22222222}}, {{4, 3}})},
+		DYNAMIC_PATCH_PC, ee);
+}
+
+TEST_F(DynamicPatchTest, EmptyPatternDoesNotEnableEarlierMatch)
+{
+	EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC, 0x22222222));
+
+	Patch::ApplyDynamicPatches(
+		{BuildDynamicPatch({{0, 0x22222222}}, {{4, 3}})},
+		{BuildDynamicPatch({}, {{0, 0x22222222}})},
+		DYNAMIC_PATCH_PC, ee);
+}
+
+TEST_F(DynamicPatchTest, ReloadDoesNotDuplicateGameDBPatches)
+{
+	EXPECT_CALL(ee, Write32(DYNAMIC_PATCH_PC + 4, 5)).Times(1);
+
+	const std::vector<Patch::DynamicPatch> patches = {BuildDynamicPatch({}, {{4, 5}})};
+	Patch::LoadDynamicPatches(patches);
+	Patch::LoadDynamicPatches(patches);
+	Patch::ApplyDynamicPatches(DYNAMIC_PATCH_PC, ee);
+}
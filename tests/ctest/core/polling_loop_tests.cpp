@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "R5900.h"
+#include "vtlb.h"
+#include "x86/iR5900Analysis.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace
+{
+	// Registers used by the hand-assembled loops below.
+	enum : u32
+	{
+		ZERO = 0,
+		A0 = 4,
+		T0 = 8,
+		T1 = 9,
+		T2 = 10,
+		RA = 31,
+	};
+
+	constexpr u32 CODE_BASE = 0x00100000;
+	constexpr u32 HELPER_BASE = CODE_BASE + 0x800;
+
+	constexpr u32 IType(u32 op, u32 rs, u32 rt, u32 imm) { return (op << 26) | (rs << 21) | (rt << 16) | (imm & 0xffff); }
+	constexpr u32 Branch(u32 op, u32 rs, u32 rt, u32 pc, u32 target) { return IType(op, rs, rt, (target - (pc + 4)) >> 2); }
+
+	constexpr u32 NOP = 0;
+	constexpr u32 LUI(u32 rt, u32 imm) { return IType(017, 0, rt, imm); }
+	constexpr u32 ORI(u32 rt, u32 rs, u32 imm) { return IType(015, rs, rt, imm); }
+	constexpr u32 ANDI(u32 rt, u32 rs, u32 imm) { return IType(014, rs, rt, imm); }
+	constexpr u32 LW(u32 rt, u32 rs, u32 imm) { return IType(043, rs, rt, imm); }
+	constexpr u32 LQ(u32 rt, u32 rs, u32 imm) { return IType(036, rs, rt, imm); }
+	constexpr u32 SW(u32 rt, u32 rs, u32 imm) { return IType(053, rs, rt, imm); }
+	constexpr u32 BEQ(u32 rs, u32 rt, u32 pc, u32 target) { return Branch(004, rs, rt, pc, target); }
+	constexpr u32 BNE(u32 rs, u32 rt, u32 pc, u32 target) { return Branch(005, rs, rt, pc, target); }
+	constexpr u32 BEQL(u32 rs, u32 rt, u32 pc, u32 target) { return Branch(024, rs, rt, pc, target); }
+	constexpr u32 BNEL(u32 rs, u32 rt, u32 pc, u32 target) { return Branch(025, rs, rt, pc, target); }
+	constexpr u32 JAL(u32 target) { return (003u << 26) | ((target >> 2) & 0x3ffffff); }
+	constexpr u32 JR(u32 rs) { return (rs << 21) | 010; }
+} // namespace
+
+class PollingLoopTest : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		m_code.fill(NOP);
+		vtlb_MapBlock(m_code.data(), CODE_BASE, sizeof(m_code));
+	}
+
+	/// Places the instructions at base and returns the address after the last one.
+	u32 Assemble(std::initializer_list<u32> code, u32 base = CODE_BASE)
+	{
+		u32 pc = base;
+		for (const u32 insn : code)
+		{
+			m_code[(pc - CODE_BASE) / 4] = insn;
+			pc += 4;
+		}
+		return pc;
+	}
+
+	bool Analyze(u32 loop_end)
+	{
+		return R5900::PollingLoopPass().Analyze(CODE_BASE, loop_end);
+	}
+
+	alignas(16) std::array<u32, 1024> m_code;
+};
+
+#define PC(n) (CODE_BASE + (n) * 4)
+
+TEST_F(PollingLoopTest, BeqPollOnIntcStat)
+{
+	const u32 end = Assemble({
+		LUI(T0, 0x1001),
+		LW(T1, T0, 0xf000),
+		ANDI(T1, T1, 4),
+		BEQ(T1, ZERO, PC(3), CODE_BASE),
+		NOP,
+	});
+	EXPECT_TRUE(Analyze(end));
+}
+
+TEST_F(PollingLoopTest, BneExitInsideLoop)
+{
+	// Normal branches leaving the loop early must not stop detection.
+	const u32 end = Assemble({
+		LUI(T0, 0x1000),
+		ORI(T0, T0, 0xe010),
+		LW(T1, T0, 0),
+		BNE(T1, ZERO, PC(3), PC(8)),
+		NOP,
+		LW(T2, T0, 4),
+		BEQ(T2, ZERO, PC(6), CODE_BASE),
+		NOP,
+	});
+	EXPECT_TRUE(Analyze(end));
+}
+
+TEST_F(PollingLoopTest, BranchLikelyExitInsideLoop)
+{
+	const u32 end = Assemble({
+		LUI(T0, 0x1000),
+		LW(T1, T0, 0x3020),
+		BNEL(T1, ZERO, PC(2), PC(6)),
+		NOP,
+		BEQ(T1, ZERO, PC(4), CODE_BASE),
+		NOP,
+	});
+	EXPECT_TRUE(Analyze(end));
+}
+
+TEST_F(PollingLoopTest, RejectsBranchBeforeLoop)
+{
+	// Branching back past the start of the loop runs code which was never looked at.
+	const u32 end = Assemble({
+		LUI(T0, 0x1001),
+		LW(T1, T0, 0xf000),
+		BNE(T1, ZERO, PC(2), CODE_BASE - 0x40),
+		NOP,
+		BEQ(T1, ZERO, PC(4), CODE_BASE),
+		NOP,
+	});
+	EXPECT_FALSE(Analyze(end));
+}
+
+TEST_F(PollingLoopTest, RejectsStore)
+{
+	const u32 end = Assemble({
+		LUI(T0, 0x1001),
+		LW(T1, T0, 0xf000),
+		SW(T1, T0, 0xf010),
+		BEQ(T1, ZERO, PC(3), CODE_BASE),
+		NOP,
+	});
+	EXPECT_FALSE(Analyze(end));
+}
+
+TEST_F(PollingLoopTest, RejectsLoadFromUnknownBase)
+{
+	// A0 comes from outside the loop, so we can't tell what is being read.
+	const u32 end = Assemble({
+		LW(T1, A0, 0),
+		BNE(T1, ZERO, PC(1), CODE_BASE),
+		NOP,
+	});
+	EXPECT_FALSE(Analyze(end));
+}
+
+TEST_F(PollingLoopTest, RejectsPointerChase)
+{
+	const u32 end = Assemble({
+		LUI(T0, 0x0020),
+		LW(T1, T0, 0),
+		LW(T2, T1, 0),
+		BEQ(T2, ZERO, PC(3), CODE_BASE),
+		NOP,
+	});
+	EXPECT_FALSE(Analyze(end));
+}
+
+TEST_F(PollingLoopTest, RejectsFifoRead)
+{
+	const u32 end = Assemble({
+		LUI(T0, 0x1000),
+		ORI(T0, T0, 0x5000),
+		LQ(T1, T0, 0),
+		BEQ(T1, ZERO, PC(3), CODE_BASE),
+		NOP,
+	});
+	EXPECT_FALSE(Analyze(end));
+}
+
+TEST_F(PollingLoopTest, CallsLeafHelper)
+{
+	Assemble({
+		LUI(T0, 0x1001),
+		JR(RA),
+		LW(T1, T0, 0xf000),
+	}, HELPER_BASE);
+
+	const u32 end = Assemble({
+		JAL(HELPER_BASE),
+		NOP,
+		BEQ(T1, ZERO, PC(2), CODE_BASE),
+		NOP,
+	});
+
+	// The helper has to be checked for changes too, not just the loop.
+	R5900::PollingLoopPass pass;
+	ASSERT_TRUE(pass.Analyze(CODE_BASE, end));
+	EXPECT_EQ(pass.GetCodeRanges(), (std::vector<std::pair<u32, u32>>{{CODE_BASE, end}, {HELPER_BASE, HELPER_BASE + 12}}));
+}
+
+TEST_F(PollingLoopTest, RejectsHelperWithBranch)
+{
+	Assemble({
+		LUI(T0, 0x1001),
+		LW(T1, T0, 0xf000),
+		BEQ(T1, ZERO, HELPER_BASE + 8, HELPER_BASE + 20),
+		NOP,
+		JR(RA),
+		NOP,
+	}, HELPER_BASE);
+
+	const u32 end = Assemble({
+		JAL(HELPER_BASE),
+		NOP,
+		BNE(T1, ZERO, PC(2), CODE_BASE),
+		NOP,
+	});
+	EXPECT_FALSE(Analyze(end));
+}
+
+TEST_F(PollingLoopTest, RejectsHelperWithBranchLikely)
+{
+	Assemble({
+		LUI(T0, 0x1001),
+		LW(T1, T0, 0xf000),
+		BEQL(T1, ZERO, HELPER_BASE + 8, HELPER_BASE + 20),
+		NOP,
+		JR(RA),
+		NOP,
+	}, HELPER_BASE);
+
+	const u32 end = Assemble({
+		JAL(HELPER_BASE),
+		NOP,
+		BNE(T1, ZERO, PC(2), CODE_BASE),
+		NOP,
+	});
+	EXPECT_FALSE(Analyze(end));
+}
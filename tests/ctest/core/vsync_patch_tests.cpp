@@ -0,0 +1,372 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Patch.h"
+
+#include "common/MemoryInterface.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <deque>
+#include <random>
+
+// Applying the compiled vsync program has to leave memory exactly as the
+// interpreter does, so every test here runs both on the same memory contents
+// and compares the results.
+
+namespace
+{
+	/// 64KiB of memory, mirrored across the whole address space.
+	class ArrayMemoryInterface final : public MemoryInterface
+	{
+	public:
+		static constexpr u32 SIZE = 0x10000;
+
+		u8 Read8(u32 address, bool* valid = nullptr) override { return Read<u8>(address, valid); }
+		u16 Read16(u32 address, bool* valid = nullptr) override { return Read<u16>(address, valid); }
+		u32 Read32(u32 address, bool* valid = nullptr) override { return Read<u32>(address, valid); }
+		u64 Read64(u32 address, bool* valid = nullptr) override { return Read<u64>(address, valid); }
+		u128 Read128(u32 address, bool* valid = nullptr) override { return Read<u128>(address, valid); }
+
+		bool ReadBytes(u32 address, void* dest, u32 size) override
+		{
+			for (u32 i = 0; i < size; i++)
+				static_cast<u8*>(dest)[i] = m_data[(address + i) & (SIZE - 1)];
+			return true;
+		}
+
+		bool Write8(u32 address, u8 value) override { return Write(address, value); }
+		bool Write16(u32 address, u16 value) override { return Write(address, value); }
+		bool Write32(u32 address, u32 value) override { return Write(address, value); }
+		bool Write64(u32 address, u64 value) override { return Write(address, value); }
+		bool Write128(u32 address, u128 value) override { return Write(address, value); }
+
+		bool WriteBytes(u32 address, const void* src, u32 size) override
+		{
+			for (u32 i = 0; i < size; i++)
+				m_data[(address + i) & (SIZE - 1)] = static_cast<const u8*>(src)[i];
+			return true;
+		}
+
+		bool CompareBytes(u32 address, const void* src, u32 size) override
+		{
+			for (u32 i = 0; i < size; i++)
+			{
+				if (m_data[(address + i) & (SIZE - 1)] != static_cast<const u8*>(src)[i])
+					return false;
+			}
+			return true;
+		}
+
+		std::array<u8, SIZE + sizeof(u128)> m_data = {};
+
+	private:
+		// Accesses can run off the end of the array by up to 15 bytes, which is
+		// the same for both sides of the comparison.
+		template <typename T>
+		T Read(u32 address, bool* valid)
+		{
+			if (valid)
+				*valid = true;
+
+			T value;
+			std::memcpy(&value, &m_data[address & (SIZE - 1)], sizeof(value));
+			return value;
+		}
+
+		template <typename T>
+		bool Write(u32 address, T value)
+		{
+			std::memcpy(&m_data[address & (SIZE - 1)], &value, sizeof(value));
+			return true;
+		}
+	};
+} // namespace
+
+class VsyncPatchTest : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		std::mt19937 rng(1234);
+		for (u8& byte : m_ee.m_data)
+			byte = (rng() % 3 == 0) ? 0 : static_cast<u8>(rng());
+		for (u8& byte : m_iop.m_data)
+			byte = static_cast<u8>(rng());
+	}
+
+	/// Starts a new group, which resets the extended code state.
+	void Group() { m_patches.push_back(nullptr); }
+
+	void Add(Patch::patch_place_type place, Patch::patch_cpu_type cpu, Patch::patch_data_type type, u32 addr, u64 data)
+	{
+		Patch::PatchCommand& command = m_commands.emplace_back();
+		command.placetopatch = place;
+		command.cpu = cpu;
+		command.type = type;
+		command.addr = addr;
+		command.data = data;
+		m_patches.push_back(&command);
+	}
+
+	void Write(Patch::patch_data_type type, u32 addr, u64 data) { Add(Patch::PPT_CONTINUOUSLY, Patch::CPU_EE, type, addr, data); }
+	void Code(u32 addr, u32 data) { Add(Patch::PPT_CONTINUOUSLY, Patch::CPU_EE, Patch::EXTENDED_T, addr, data); }
+
+	void Poke16(u32 addr, u16 value) { std::memcpy(&m_ee.m_data[addr & (ArrayMemoryInterface::SIZE - 1)], &value, sizeof(value)); }
+
+	/// Applies the patches for a few frames, through the interpreter and the compiled program, and checks that
+	/// both end up with the same memory. Returns the number of ops which were left to the interpreter.
+	u32 ApplyAndCompare(u32 frames = 3)
+	{
+		ArrayMemoryInterface interpreted_ee = m_ee;
+		ArrayMemoryInterface interpreted_iop = m_iop;
+		ArrayMemoryInterface compiled_ee = m_ee;
+		ArrayMemoryInterface compiled_iop = m_iop;
+
+		u32 interpreted_ops = 0;
+		for (u32 frame = 0; frame < frames; frame++)
+		{
+			Patch::ApplyPatches(m_patches, Patch::PPT_CONTINUOUSLY, interpreted_ee, interpreted_iop);
+			Patch::ApplyPatches(m_patches, Patch::PPT_COMBINED_0_1, interpreted_ee, interpreted_iop);
+			interpreted_ops = Patch::ApplyCompiledVsyncPatches(m_patches, compiled_ee, compiled_iop);
+
+			EXPECT_EQ(interpreted_ee.m_data, compiled_ee.m_data) << "EE memory differs after frame " << frame;
+			EXPECT_EQ(interpreted_iop.m_data, compiled_iop.m_data) << "IOP memory differs after frame " << frame;
+		}
+
+		return interpreted_ops;
+	}
+
+	ArrayMemoryInterface m_ee;
+	ArrayMemoryInterface m_iop;
+	std::deque<Patch::PatchCommand> m_commands;
+	std::vector<const Patch::PatchCommand*> m_patches;
+};
+
+TEST_F(VsyncPatchTest, Writes)
+{
+	Write(Patch::BYTE_T, 0x00100001, 0x12);
+	Write(Patch::SHORT_T, 0x00100002, 0x1234);
+	Write(Patch::WORD_T, 0x00100004, 0x12345678);
+	Write(Patch::DOUBLE_T, 0x00100008, 0x123456789abcdef0);
+	Write(Patch::SHORT_BE_T, 0x00100012, 0x1234);
+	Write(Patch::WORD_BE_T, 0x00100014, 0x12345678);
+	Write(Patch::DOUBLE_BE_T, 0x00100018, 0x123456789abcdef0);
+	Add(Patch::PPT_CONTINUOUSLY, Patch::CPU_IOP, Patch::BYTE_T, 0x00001001, 0x12);
+	Add(Patch::PPT_CONTINUOUSLY, Patch::CPU_IOP, Patch::SHORT_T, 0x00001002, 0x1234);
+	Add(Patch::PPT_CONTINUOUSLY, Patch::CPU_IOP, Patch::WORD_T, 0x00001004, 0x12345678);
+	Add(Patch::PPT_COMBINED_0_1, Patch::CPU_EE, Patch::WORD_T, 0x00100020, 0xdeadbeef);
+	Add(Patch::PPT_ONCE_ON_LOAD, Patch::CPU_EE, Patch::WORD_T, 0x00100024, 0xdeadbeef);
+	EXPECT_EQ(ApplyAndCompare(), 0u);
+}
+
+TEST_F(VsyncPatchTest, ExtendedSingleLineCodes)
+{
+	Code(0x00100001, 0x00000012);
+	Code(0x10100002, 0x00001234);
+	Code(0x20100004, 0x12345678);
+	Code(0x300000ff, 0x00100010); // 8-bit increment
+	Code(0x30100001, 0x00100011); // 8-bit decrement
+	Code(0x3020ffff, 0x00100012); // 16-bit increment
+	Code(0x30300001, 0x00100014); // 16-bit decrement
+	Code(0x70100020, 0x00000f0f); // 8-bit or
+	Code(0x70100022, 0x00100f0f); // 16-bit or
+	Code(0x70100024, 0x002000f0); // 8-bit and
+	Code(0x70100026, 0x00300f00); // 16-bit and
+	Code(0x70100028, 0x004000ff); // 8-bit xor
+	Code(0x7010002a, 0x0050ffff); // 16-bit xor
+	EXPECT_EQ(ApplyAndCompare(), 0u);
+}
+
+TEST_F(VsyncPatchTest, ExtendedMultiLineCodes)
+{
+	Code(0x30400000, 0x00100000); // 32-bit increment
+	Code(0x12345678, 0x00000000);
+	Code(0x30500000, 0x00100004); // 32-bit decrement
+	Code(0x00000001, 0x00000000);
+	Code(0x40100010, 0x00040002); // Fill 4 words, 2 words apart
+	Code(0x11111111, 0x00000101);
+	Code(0x50100100, 0x00000020); // Copy 0x20 bytes
+	Code(0x00100200, 0x00000000);
+	EXPECT_EQ(ApplyAndCompare(), 0u);
+}
+
+TEST_F(VsyncPatchTest, PointerCodeIsInterpreted)
+{
+	Code(0x00100001, 0x00000012);
+	Code(0x60100000, 0x00000012); // Pointer write through three pointers
+	Code(0x00000003, 0x00000004);
+	Code(0x00000008, 0x0000000c);
+	Code(0x00100002, 0x00000034);
+	EXPECT_EQ(ApplyAndCompare(), 1u);
+}
+
+TEST_F(VsyncPatchTest, ConditionalSkips)
+{
+	for (const u32 type : {0u, 1u})
+	{
+		for (u32 cond = 0; cond < 8; cond++)
+		{
+			for (const u16 value : {u16{0x0000}, u16{0x1234}, u16{0x5678}})
+			{
+				SetUp();
+				m_commands.clear();
+				m_patches.clear();
+				Poke16(0x00100000, 0x1234);
+
+				// D: skip the next three lines, which are two codes.
+				Code(0xD0100000, (3 << 24) | (cond << 20) | (type << 16) | value);
+				Code(0x00100010, 0x00000012);
+				Code(0x30400000, 0x00100014);
+				Code(0x00000001, 0x00000000);
+				Code(0x00100011, 0x00000034);
+
+				// E: skip the next line.
+				Code(0xE0000000 | (type << 24) | (1 << 16) | value, (cond << 28) | 0x00100000);
+				Code(0x00100020, 0x00000056);
+				Code(0x00100021, 0x00000078);
+
+				EXPECT_EQ(ApplyAndCompare(), 0u) << "type " << type << " cond " << cond << " value " << value;
+			}
+		}
+	}
+}
+
+TEST_F(VsyncPatchTest, ConditionalSkipPastEndOfGroup)
+{
+	Code(0xD0100000, 0x05000000);
+	Code(0x00100010, 0x00000012);
+	Group();
+	Code(0x00100011, 0x00000034);
+	EXPECT_EQ(ApplyAndCompare(), 0u);
+}
+
+TEST_F(VsyncPatchTest, CodesCutShortByEndOfGroup)
+{
+	Code(0x00100001, 0x00000012);
+	Code(0x30400000, 0x00100000);
+	Group();
+	Code(0x40100010, 0x00040002);
+	Group();
+	Code(0x50100100, 0x00000020);
+	Group();
+	Code(0x60100000, 0x00000012);
+	Code(0x00000005, 0x00000004);
+	Code(0x00000008, 0x0000000c);
+	Group();
+	Code(0x00100002, 0x00000034);
+	EXPECT_EQ(ApplyAndCompare(), 0u);
+}
+
+TEST_F(VsyncPatchTest, FallsBackForSkipIntoCode)
+{
+	// The skip lands on the second line of the fill code.
+	Code(0xD0100000, 0x01001234);
+	Code(0x40100010, 0x00040002);
+	Code(0x00100020, 0x00000012);
+	Code(0x00100030, 0x00000034);
+	EXPECT_EQ(ApplyAndCompare(), 1u);
+}
+
+TEST_F(VsyncPatchTest, FallsBackForSkipOverOtherCommands)
+{
+	Code(0xD0100000, 0x01001234);
+	Write(Patch::WORD_T, 0x00100010, 0x12345678);
+	Code(0x00100020, 0x00000012);
+	Code(0x00100030, 0x00000034);
+	EXPECT_EQ(ApplyAndCompare(), 1u);
+}
+
+TEST_F(VsyncPatchTest, FallsBackForCommandInsideCode)
+{
+	Code(0x00100001, 0x00000012);
+	Group();
+	Code(0x30400000, 0x00100000);
+	Write(Patch::WORD_T, 0x00100000, 0x12345678);
+	Code(0x00000001, 0x00000000);
+	EXPECT_EQ(ApplyAndCompare(), 1u);
+}
+
+TEST_F(VsyncPatchTest, RandomPatchLists)
+{
+	std::mt19937 rng(5678);
+	for (u32 iteration = 0; iteration < 500; iteration++)
+	{
+		SetUp();
+		m_commands.clear();
+		m_patches.clear();
+
+		const u32 num_groups = 1 + rng() % 4;
+		for (u32 group = 0; group < num_groups; group++)
+		{
+			Group();
+
+			const u32 num_commands = 1 + rng() % 12;
+			for (u32 i = 0; i < num_commands; i++)
+			{
+				const Patch::patch_place_type place = (rng() % 4 == 0) ? Patch::PPT_COMBINED_0_1 :
+				                                      (rng() % 6 == 0) ? Patch::PPT_ONCE_ON_LOAD :
+				                                                         Patch::PPT_CONTINUOUSLY;
+				if (rng() % 10 >= 7)
+				{
+					static constexpr Patch::patch_data_type types[] = {Patch::BYTE_T, Patch::SHORT_T, Patch::WORD_T,
+						Patch::DOUBLE_T, Patch::SHORT_BE_T, Patch::WORD_BE_T, Patch::DOUBLE_BE_T};
+					const Patch::patch_cpu_type cpu = (rng() % 5 == 0) ? Patch::CPU_IOP : Patch::CPU_EE;
+					const Patch::patch_data_type type = types[rng() % ((cpu == Patch::CPU_IOP) ? 3 : 7)];
+					Add(place, cpu, type, rng() & 0xfff8, (u64{rng()} << 32) | rng());
+					continue;
+				}
+
+				// Mostly well formed codes, with some garbage which will end up as the second line of a code.
+				static constexpr u32 prefixes[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0xD, 0xE, 0xD, 0xE, 0x9};
+				const u32 prefix = prefixes[rng() % std::size(prefixes)];
+				u32 addr = (prefix << 28) | (rng() & 0xfffe);
+				u32 data = rng() & 0xffff;
+				switch (prefix)
+				{
+					case 0x3:
+						addr = 0x30000000 | ((rng() % 7) << 20) | (rng() & 0xff);
+						data = rng() & 0xfffc;
+						break;
+					case 0x4:
+						data = ((rng() % 8) << 16) | (rng() % 4);
+						break;
+					case 0x5:
+						data = rng() % 16;
+						break;
+					case 0x6:
+						data = rng() & 0xff;
+						break;
+					case 0x7:
+						data = ((rng() % 7) << 20) | (rng() & 0xffff);
+						break;
+					case 0xD:
+						data = ((rng() % 4) << 24) | ((rng() % 9) << 20) | ((rng() % 3) << 16) |
+						       ((rng() % 4 == 0) ? (rng() & 0xffff) : 0);
+						break;
+					case 0xE:
+						addr = 0xE0000000 | ((rng() % 3) << 24) | ((rng() % 4) << 16) |
+						       ((rng() % 4 == 0) ? (rng() & 0xffff) : 0);
+						data = ((rng() % 8) << 28) | (rng() & 0xfffe);
+						break;
+					default:
+						break;
+				}
+				if (rng() % 5 == 0)
+				{
+					addr = (rng() & 0xffff) | ((rng() % 3) << 16);
+					data = rng() & 0xffff;
+				}
+
+				const Patch::patch_cpu_type cpu = (rng() % 10 == 0) ? Patch::CPU_IOP : Patch::CPU_EE;
+				Add(place, cpu, Patch::EXTENDED_T, addr, data);
+			}
+		}
+
+		ApplyAndCompare();
+		if (HasFailure())
+			FAIL() << "Patch list " << iteration << " differs from the interpreter";
+	}
+}